@@ -1,7 +1,12 @@
 #pragma once
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <random>
 #include <span>
+#include <utility>
 #include <vector>
 
 const auto compute_min = [](const std::vector<double>& v) -> double { return *std::min_element(v.begin(), v.end()); };
@@ -22,3 +27,44 @@ generate_random_data(std::span<T> data)
     data[i] = dis(gen);
   }
 }
+
+// Never inlined function, with ~100 bytes of code, which is distinct for each `i`, so that calling all of them walks over a lot of instruction memory.
+template<size_t i>
+[[gnu::noinline]] uint64_t
+icache_polluter(uint64_t x)
+{
+  constexpr uint64_t k = 0x9e3779b97f4a7c15UL * (i + 1);
+
+  x = std::rotl((x ^ k) * 0xff51afd7ed558ccdUL, static_cast<int>((i % 61) + 1));
+  x = std::rotl((x + k) * 0xc4ceb9fe1a85ec53UL, static_cast<int>((i % 59) + 2));
+  x = std::rotl((x ^ (k >> 7)) * 0x94d049bb133111ebUL, static_cast<int>((i % 53) + 3));
+  x = std::rotl((x + (k >> 13)) * 0xbf58476d1ce4e5b9UL, static_cast<int>((i % 47) + 4));
+
+  return x;
+}
+
+// # -of distinct `icache_polluter` functions, whose combined code size is well beyond L1 instruction cache of contemporary CPUs.
+static constexpr size_t ICACHE_POLLUTER_CNT = 1024;
+
+template<size_t... i>
+static constexpr std::array<uint64_t (*)(uint64_t), sizeof...(i)>
+make_icache_polluters(std::index_sequence<i...> /* unused */)
+{
+  return { icache_polluter<i>... };
+}
+
+/**
+ * Evicts (most of) the benchmarked code from L1 instruction cache, by calling `ICACHE_POLLUTER_CNT` -many distinct functions, one after another. Call it
+ * between two invocations of the benchmarked code, for measuring it the way it runs in a large binary, where it rarely stays hot in the I-cache.
+ */
+static inline uint64_t
+pollute_icache(uint64_t x)
+{
+  static constexpr auto polluters = make_icache_polluters(std::make_index_sequence<ICACHE_POLLUTER_CNT>{});
+
+  for (const auto polluter : polluters) {
+    x = polluter(x);
+  }
+
+  return x;
+}
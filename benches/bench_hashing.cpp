@@ -3,8 +3,14 @@
 #include "sha3/sha3_256.hpp"
 #include "sha3/sha3_384.hpp"
 #include "sha3/sha3_512.hpp"
+#include <array>
 #include <benchmark/benchmark.h>
+#include <cmath>
 #include <cstdint>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <vector>
 
 namespace {
 
@@ -108,9 +114,205 @@ bench_sha3_512(benchmark::State& state)
 #endif
 }
 
+
+/**
+ * Benchmarks SHA3-256 hash function on a batch of `batch` independent messages, each of variable length, either using batched one-shot hashing API
+ * `hash_many`, when `many` is set, or calling `hash` in a loop, s.t. both can be compared.
+ */
+template<bool many>
+void
+bench_sha3_256_batch(benchmark::State& state)
+{
+  const auto mlen = static_cast<size_t>(state.range(0));
+  const auto batch = static_cast<size_t>(state.range(1));
+
+  std::vector<uint8_t> msgs(mlen * batch);
+  generate_random_data<uint8_t>(msgs);
+
+  std::vector<std::span<const uint8_t>> msg_spans(batch);
+  for (size_t i = 0; i < batch; i++) {
+    msg_spans[i] = std::span(msgs).subspan(i * mlen, mlen);
+  }
+
+  std::vector<std::array<uint8_t, sha3_256::DIGEST_LEN>> mds(batch);
+
+  for (auto _ : state) {
+    if constexpr (many) {
+      sha3_256::sha3_256_t::hash_many(msg_spans, mds);
+    } else {
+      for (size_t i = 0; i < batch; i++) {
+        mds[i] = sha3_256::sha3_256_t::hash(msg_spans[i]);
+      }
+    }
+
+    benchmark::DoNotOptimize(msgs);
+    benchmark::DoNotOptimize(mds);
+    benchmark::ClobberMemory();
+  }
+
+  const size_t bytes_processed = state.iterations() * batch * (mlen + sha3_256::DIGEST_LEN);
+  state.SetBytesProcessed(static_cast<int64_t>(bytes_processed));
+
+#ifdef CYCLES_PER_BYTE
+  state.counters["CYCLES/ BYTE"] = state.counters["CYCLES"] / static_cast<double>(bytes_processed);
+#endif
+}
+
+// Ways of hashing a batch of messages, of unequal length, compared by `bench_sha3_256_mixed`.
+enum class batch_api_t : uint8_t
+{
+  hash_loop,
+  hash_many,
+  job_manager_x4,
+  job_manager_x8,
+};
+
+/**
+ * Benchmarks SHA3-256 hash function on a batch of `batch` independent messages, whose lengths are drawn log-uniformly from [16, 16384] -bytes, s.t. most
+ * messages are short, while a few are long, which is what a server hashing a stream of requests sees.
+ */
+template<batch_api_t api>
+void
+bench_sha3_256_mixed(benchmark::State& state)
+{
+  const auto batch = static_cast<size_t>(state.range(0));
+
+  std::mt19937_64 gen(batch);
+  std::uniform_real_distribution<double> log_len(std::log(16.), std::log(16384.));
+
+  std::vector<std::vector<uint8_t>> msgs(batch);
+  std::vector<std::span<const uint8_t>> msg_spans(batch);
+  size_t total_mlen = 0;
+
+  for (size_t i = 0; i < batch; i++) {
+    msgs[i].resize(static_cast<size_t>(std::exp(log_len(gen))));
+    generate_random_data<uint8_t>(msgs[i]);
+
+    msg_spans[i] = msgs[i];
+    total_mlen += msgs[i].size();
+  }
+
+  std::vector<std::array<uint8_t, sha3_256::DIGEST_LEN>> mds(batch);
+
+  for (auto _ : state) {
+    if constexpr (api == batch_api_t::hash_loop) {
+      for (size_t i = 0; i < batch; i++) {
+        mds[i] = sha3_256::sha3_256_t::hash(msg_spans[i]);
+      }
+    } else if constexpr (api == batch_api_t::hash_many) {
+      sha3_256::sha3_256_t::hash_many(msg_spans, mds);
+    } else {
+      using job_manager_t = std::conditional_t<api == batch_api_t::job_manager_x4, sha3_256::job_manager_t, sha3_256::job_manager_x8_t>;
+
+      job_manager_t manager([](const sponge::job_id_t) {});
+      for (size_t i = 0; i < batch; i++) {
+        manager.submit(msg_spans[i], mds[i]);
+      }
+      manager.flush();
+    }
+
+    benchmark::DoNotOptimize(msgs);
+    benchmark::DoNotOptimize(mds);
+    benchmark::ClobberMemory();
+  }
+
+  const size_t bytes_processed = state.iterations() * (total_mlen + (batch * sha3_256::DIGEST_LEN));
+  state.SetBytesProcessed(static_cast<int64_t>(bytes_processed));
+
+#ifdef CYCLES_PER_BYTE
+  state.counters["CYCLES/ BYTE"] = state.counters["CYCLES"] / static_cast<double>(bytes_processed);
+#endif
+}
+
+/**
+ * Benchmarks SHA3-256 hash function on a `mlen` -byte message, whose length is known at compile-time, either through the fixed length input overload of
+ * `hash`, when `fixed` is set, or through the generic one, s.t. both can be compared.
+ */
+template<size_t mlen, bool fixed>
+void
+bench_sha3_256_fixed_len(benchmark::State& state)
+{
+  std::array<uint8_t, mlen> msg{};
+  generate_random_data<uint8_t>(msg);
+
+  for (auto _ : state) {
+    std::array<uint8_t, sha3_256::DIGEST_LEN> md{};
+    if constexpr (fixed) {
+      md = sha3_256::sha3_256_t::hash(std::span<const uint8_t, mlen>(msg));
+    } else {
+      md = sha3_256::sha3_256_t::hash(std::span<const uint8_t>(msg));
+    }
+
+    benchmark::DoNotOptimize(msg);
+    benchmark::DoNotOptimize(md);
+    benchmark::ClobberMemory();
+  }
+
+  const size_t bytes_processed = state.iterations() * (msg.size() + sha3_256::DIGEST_LEN);
+  state.SetBytesProcessed(static_cast<int64_t>(bytes_processed));
+
+#ifdef CYCLES_PER_BYTE
+  state.counters["CYCLES/ BYTE"] = state.counters["CYCLES"] / static_cast<double>(bytes_processed);
+#endif
+}
+
 }
 
 BENCHMARK(bench_sha3_224)->RangeMultiplier(4)->Range(64, 16384)->Name("sha3_224")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
 BENCHMARK(bench_sha3_256)->RangeMultiplier(4)->Range(64, 16384)->Name("sha3_256")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
 BENCHMARK(bench_sha3_384)->RangeMultiplier(4)->Range(64, 16384)->Name("sha3_384")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
 BENCHMARK(bench_sha3_512)->RangeMultiplier(4)->Range(64, 16384)->Name("sha3_512")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sha3_256_batch<false>)
+  ->ArgsProduct({ benchmark::CreateRange(32, 4096, 8), { 64 } })
+  ->Name("sha3_256 hash loop")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sha3_256_batch<true>)
+  ->ArgsProduct({ benchmark::CreateRange(32, 4096, 8), { 64 } })
+  ->Name("sha3_256 hash_many")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sha3_256_mixed<batch_api_t::hash_loop>)
+  ->Arg(256)
+  ->Name("sha3_256 mixed hash loop")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sha3_256_mixed<batch_api_t::hash_many>)
+  ->Arg(256)
+  ->Name("sha3_256 mixed hash_many")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sha3_256_mixed<batch_api_t::job_manager_x4>)
+  ->Arg(256)
+  ->Name("sha3_256 mixed job_manager x4")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sha3_256_mixed<batch_api_t::job_manager_x8>)
+  ->Arg(256)
+  ->Name("sha3_256 mixed job_manager x8")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sha3_256_fixed_len<32, false>)
+  ->Name("sha3_256/32 generic")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sha3_256_fixed_len<32, true>)
+  ->Name("sha3_256/32 fixed")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sha3_256_fixed_len<64, false>)
+  ->Name("sha3_256/64 generic")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sha3_256_fixed_len<64, true>)
+  ->Name("sha3_256/64 fixed")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sha3_256_fixed_len<128, false>)
+  ->Name("sha3_256/128 generic")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sha3_256_fixed_len<128, true>)
+  ->Name("sha3_256/128 fixed")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
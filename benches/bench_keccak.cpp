@@ -1,11 +1,23 @@
 #include "bench_common.hpp"
 #include "sha3/internals/keccak.hpp"
+#include "sha3/internals/keccak_bit_interleaved.hpp"
+#include "sha3/internals/keccak_x2.hpp"
+#include "sha3/internals/keccak_x4.hpp"
+#include "sha3/internals/keccak_x8.hpp"
 #include <benchmark/benchmark.h>
+#include <chrono>
 #include <cstdint>
+#include <string>
 
 namespace {
 
-// Benchmarks Keccak-p[1600, 12] or Keccak-p[1600, 24] permutation.
+// Records which backend powers Keccak-p[1600] permutation and sponge loops, in the context of benchmark report.
+const bool backend_context_added = []() {
+  benchmark::AddCustomContext("sha3_backend", std::string(keccak::backend_name(keccak::active_backend())));
+  return true;
+}();
+
+// Benchmarks Keccak-p[1600, 12] or Keccak-p[1600, 24] permutation, using the best backend available on this CPU.
 template<size_t num_rounds>
 void
 bench_keccak_permutation(benchmark::State& state)
@@ -28,7 +40,413 @@ bench_keccak_permutation(benchmark::State& state)
 #endif
 }
 
+// Benchmarks Keccak-p[1600, 12] or Keccak-p[1600, 24] permutation, using the requested backend. Skipped if the CPU doesn't support it.
+template<size_t num_rounds, keccak::backend_t backend>
+void
+bench_keccak_permutation_using(benchmark::State& state)
+{
+  if (!keccak::is_backend_supported(backend)) {
+    state.SkipWithError("Backend is not supported by this CPU");
+    return;
+  }
+
+  const auto permute = keccak::permute_fn<num_rounds>(backend);
+
+  std::array<uint64_t, keccak::LANE_CNT> st{};
+  generate_random_data<uint64_t>(st);
+
+  for (auto _ : state) {
+    permute(st);
+
+    benchmark::DoNotOptimize(st);
+    benchmark::ClobberMemory();
+  }
+
+  const size_t bytes_processed = state.iterations() * sizeof(st);
+  state.SetBytesProcessed(static_cast<int64_t>(bytes_processed));
+
+#ifdef CYCLES_PER_BYTE
+  state.counters["CYCLES/ BYTE"] = state.counters["CYCLES"] / static_cast<double>(bytes_processed);
+#endif
+}
+
+// Benchmarks portable Keccak-p[1600, 12] or Keccak-p[1600, 24] permutation, using the requested variant of χ step mapping function. The `andn` variant is
+// skipped if the CPU doesn't support BMI1.
+template<size_t num_rounds, keccak::chi_t chi>
+void
+bench_keccak_permutation_chi(benchmark::State& state)
+{
+  if ((chi == keccak::chi_t::andn) && !cpu_features::has_bmi()) {
+    state.SkipWithError("BMI1 is not supported by this CPU");
+    return;
+  }
+
+  std::array<uint64_t, keccak::LANE_CNT> st{};
+  generate_random_data<uint64_t>(st);
+
+  for (auto _ : state) {
+    keccak::permute<num_rounds, chi>(st);
+
+    benchmark::DoNotOptimize(st);
+    benchmark::ClobberMemory();
+  }
+
+  const size_t bytes_processed = state.iterations() * sizeof(st);
+  state.SetBytesProcessed(static_cast<int64_t>(bytes_processed));
+
+#ifdef CYCLES_PER_BYTE
+  state.counters["CYCLES/ BYTE"] = state.counters["CYCLES"] / static_cast<double>(bytes_processed);
+#endif
+}
+
+// Benchmarks bit-interleaved Keccak-p[1600, 12] or Keccak-p[1600, 24] permutation, which is the scalar backend on 32 -bit targets. Build with `-m32` for
+// measuring it where it's meant to run.
+template<size_t num_rounds>
+void
+bench_keccak_permutation_bit_interleaved(benchmark::State& state)
+{
+  std::array<uint64_t, keccak::LANE_CNT> st{};
+  generate_random_data<uint64_t>(st);
+
+  for (auto _ : state) {
+    keccak::bit_interleaved::permute<num_rounds>(st);
+
+    benchmark::DoNotOptimize(st);
+    benchmark::ClobberMemory();
+  }
+
+  const size_t bytes_processed = state.iterations() * sizeof(st);
+  state.SetBytesProcessed(static_cast<int64_t>(bytes_processed));
+
+#ifdef CYCLES_PER_BYTE
+  state.counters["CYCLES/ BYTE"] = state.counters["CYCLES"] / static_cast<double>(bytes_processed);
+#endif
+}
+
+// Portable Keccak-p[1600] permutation, with the round loop unrolled `unroll` -times, which is never inlined, so that its code size is what's measured.
+template<size_t num_rounds, size_t unroll>
+[[gnu::noinline]] void
+permute_unrolled(std::array<uint64_t, keccak::LANE_CNT>& state)
+{
+  keccak::permute_portable<num_rounds, keccak::chi_t::standard, unroll>(state);
+}
+
+// Benchmarks portable Keccak-p[1600, 12] or Keccak-p[1600, 24] permutation, with the round loop unrolled `unroll` -times, while it stays hot in I-cache.
+template<size_t num_rounds, size_t unroll>
+void
+bench_keccak_permutation_unroll(benchmark::State& state)
+{
+  std::array<uint64_t, keccak::LANE_CNT> st{};
+  generate_random_data<uint64_t>(st);
+
+  for (auto _ : state) {
+    permute_unrolled<num_rounds, unroll>(st);
+
+    benchmark::DoNotOptimize(st);
+    benchmark::ClobberMemory();
+  }
+
+  const size_t bytes_processed = state.iterations() * sizeof(st);
+  state.SetBytesProcessed(static_cast<int64_t>(bytes_processed));
+}
+
+/**
+ * Benchmarks portable Keccak-p[1600, 12] or Keccak-p[1600, 24] permutation, with the round loop unrolled `unroll` -times, when its code is evicted from
+ * L1 I-cache, before every invocation, see `pollute_icache`. Only the permutation is timed, using manual timing.
+ */
+template<size_t num_rounds, size_t unroll>
+void
+bench_keccak_permutation_unroll_cold_icache(benchmark::State& state)
+{
+  std::array<uint64_t, keccak::LANE_CNT> st{};
+  generate_random_data<uint64_t>(st);
+
+  for (auto _ : state) {
+    st[0] = pollute_icache(st[0]);
+
+    const auto start = std::chrono::steady_clock::now();
+    permute_unrolled<num_rounds, unroll>(st);
+    benchmark::DoNotOptimize(st);
+    benchmark::ClobberMemory();
+    const auto end = std::chrono::steady_clock::now();
+
+    state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+  }
+
+  const size_t bytes_processed = state.iterations() * sizeof(st);
+  state.SetBytesProcessed(static_cast<int64_t>(bytes_processed));
+}
+
+// Benchmarks 2-way multi-buffer Keccak-p[1600, 12] or Keccak-p[1600, 24] permutation, which uses the ARMv8.2 SHA3 extension, when available.
+template<size_t num_rounds>
+void
+bench_keccak_permutation_x2(benchmark::State& state)
+{
+  std::array<uint64_t, keccak::LANE_CNT * keccak::X2_STATE_CNT> st{};
+  generate_random_data<uint64_t>(st);
+
+  for (auto _ : state) {
+    keccak::permute_x2<num_rounds>(st);
+
+    benchmark::DoNotOptimize(st);
+    benchmark::ClobberMemory();
+  }
+
+  const size_t bytes_processed = state.iterations() * sizeof(st);
+  state.SetBytesProcessed(static_cast<int64_t>(bytes_processed));
+
+#ifdef CYCLES_PER_BYTE
+  state.counters["CYCLES/ BYTE"] = state.counters["CYCLES"] / static_cast<double>(bytes_processed);
+#endif
+}
+
+// Benchmarks 4-way multi-buffer Keccak-p[1600, 12] or Keccak-p[1600, 24] permutation, applied on four independent states at once.
+template<size_t num_rounds>
+void
+bench_keccak_permutation_x4(benchmark::State& state)
+{
+  std::array<uint64_t, keccak::LANE_CNT * keccak::X4_STATE_CNT> st{};
+  generate_random_data<uint64_t>(st);
+
+  for (auto _ : state) {
+    keccak::permute_x4<num_rounds>(st);
+
+    benchmark::DoNotOptimize(st);
+    benchmark::ClobberMemory();
+  }
+
+  const size_t bytes_processed = state.iterations() * sizeof(st);
+  state.SetBytesProcessed(static_cast<int64_t>(bytes_processed));
+
+#ifdef CYCLES_PER_BYTE
+  state.counters["CYCLES/ BYTE"] = state.counters["CYCLES"] / static_cast<double>(bytes_processed);
+#endif
+}
+
+/**
+ * Benchmarks a batch of `state_cnt` (1, 2 or 4) independent states, permuted using scalar instructions only. A single state is permuted using the portable
+ * implementation, while pairs of states are permuted using the 2-way interleaved one, see `permute_x2_portable`, s.t. throughput of both can be compared.
+ */
+template<size_t num_rounds, size_t state_cnt>
+void
+bench_keccak_permutation_scalar_batch(benchmark::State& state)
+{
+  static_assert((state_cnt == 1) || (state_cnt % keccak::X2_STATE_CNT == 0), "Batch must be a single state or pairs of states.");
+
+  std::array<uint64_t, keccak::LANE_CNT * state_cnt> st{};
+  generate_random_data<uint64_t>(st);
+
+  for (auto _ : state) {
+    if constexpr (state_cnt == 1) {
+      keccak::permute_portable<num_rounds>(st);
+    } else {
+      for (size_t off = 0; off < st.size(); off += keccak::LANE_CNT * keccak::X2_STATE_CNT) {
+        keccak::permute_x2_portable<num_rounds>(std::span(st).subspan(off).template first<keccak::LANE_CNT * keccak::X2_STATE_CNT>());
+      }
+    }
+
+    benchmark::DoNotOptimize(st);
+    benchmark::ClobberMemory();
+  }
+
+  const size_t bytes_processed = state.iterations() * sizeof(st);
+  state.SetBytesProcessed(static_cast<int64_t>(bytes_processed));
+
+#ifdef CYCLES_PER_BYTE
+  state.counters["CYCLES/ BYTE"] = state.counters["CYCLES"] / static_cast<double>(bytes_processed);
+#endif
+}
+
+// Benchmarks 8-way multi-buffer Keccak-p[1600, 12] or Keccak-p[1600, 24] permutation, applied on eight independent states at once.
+template<size_t num_rounds>
+void
+bench_keccak_permutation_x8(benchmark::State& state)
+{
+  std::array<uint64_t, keccak::LANE_CNT * keccak::X8_STATE_CNT> st{};
+  generate_random_data<uint64_t>(st);
+
+  for (auto _ : state) {
+    keccak::permute_x8<num_rounds>(st);
+
+    benchmark::DoNotOptimize(st);
+    benchmark::ClobberMemory();
+  }
+
+  const size_t bytes_processed = state.iterations() * sizeof(st);
+  state.SetBytesProcessed(static_cast<int64_t>(bytes_processed));
+
+#ifdef CYCLES_PER_BYTE
+  state.counters["CYCLES/ BYTE"] = state.counters["CYCLES"] / static_cast<double>(bytes_processed);
+#endif
+}
+
 }
 
 BENCHMARK(bench_keccak_permutation<12>)->Name("keccak-p[1600, 12]")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
 BENCHMARK(bench_keccak_permutation<24>)->Name("keccak-p[1600, 24]")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_using<12, keccak::backend_t::scalar>)
+  ->Name("keccak-p[1600, 12] scalar")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_using<24, keccak::backend_t::scalar>)
+  ->Name("keccak-p[1600, 24] scalar")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_using<12, keccak::backend_t::bmi>)
+  ->Name("keccak-p[1600, 12] bmi")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_using<24, keccak::backend_t::bmi>)
+  ->Name("keccak-p[1600, 24] bmi")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_using<12, keccak::backend_t::avx2>)
+  ->Name("keccak-p[1600, 12] avx2")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_using<24, keccak::backend_t::avx2>)
+  ->Name("keccak-p[1600, 24] avx2")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_using<12, keccak::backend_t::avx512>)
+  ->Name("keccak-p[1600, 12] avx512")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_using<24, keccak::backend_t::avx512>)
+  ->Name("keccak-p[1600, 24] avx512")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_using<12, keccak::backend_t::neon_sha3>)
+  ->Name("keccak-p[1600, 12] neon_sha3")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_using<24, keccak::backend_t::neon_sha3>)
+  ->Name("keccak-p[1600, 24] neon_sha3")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_chi<12, keccak::chi_t::andn>)
+  ->Name("keccak-p[1600, 12] chi=andn")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_chi<24, keccak::chi_t::andn>)
+  ->Name("keccak-p[1600, 24] chi=andn")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_chi<12, keccak::chi_t::lane_complementing>)
+  ->Name("keccak-p[1600, 12] chi=lane-complementing")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_chi<24, keccak::chi_t::lane_complementing>)
+  ->Name("keccak-p[1600, 24] chi=lane-complementing")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_bit_interleaved<12>)
+  ->Name("keccak-p[1600, 12] bit-interleaved")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_bit_interleaved<24>)
+  ->Name("keccak-p[1600, 24] bit-interleaved")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_unroll<12, 1>)
+  ->Name("keccak-p[1600, 12] unroll=1")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_unroll<12, 2>)
+  ->Name("keccak-p[1600, 12] unroll=2")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_unroll<12, 4>)
+  ->Name("keccak-p[1600, 12] unroll=4")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_unroll<12, 24>)
+  ->Name("keccak-p[1600, 12] unroll=24")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_unroll<24, 1>)
+  ->Name("keccak-p[1600, 24] unroll=1")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_unroll<24, 2>)
+  ->Name("keccak-p[1600, 24] unroll=2")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_unroll<24, 4>)
+  ->Name("keccak-p[1600, 24] unroll=4")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_unroll<24, 24>)
+  ->Name("keccak-p[1600, 24] unroll=24")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_unroll_cold_icache<12, 1>)
+  ->Name("keccak-p[1600, 12] unroll=1 cold-icache")
+  ->UseManualTime()
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_unroll_cold_icache<12, 2>)
+  ->Name("keccak-p[1600, 12] unroll=2 cold-icache")
+  ->UseManualTime()
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_unroll_cold_icache<12, 4>)
+  ->Name("keccak-p[1600, 12] unroll=4 cold-icache")
+  ->UseManualTime()
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_unroll_cold_icache<12, 24>)
+  ->Name("keccak-p[1600, 12] unroll=24 cold-icache")
+  ->UseManualTime()
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_unroll_cold_icache<24, 1>)
+  ->Name("keccak-p[1600, 24] unroll=1 cold-icache")
+  ->UseManualTime()
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_unroll_cold_icache<24, 2>)
+  ->Name("keccak-p[1600, 24] unroll=2 cold-icache")
+  ->UseManualTime()
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_unroll_cold_icache<24, 4>)
+  ->Name("keccak-p[1600, 24] unroll=4 cold-icache")
+  ->UseManualTime()
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_unroll_cold_icache<24, 24>)
+  ->Name("keccak-p[1600, 24] unroll=24 cold-icache")
+  ->UseManualTime()
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_scalar_batch<12, 1>)
+  ->Name("keccak-p[1600, 12] scalar batch=1")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_scalar_batch<12, 2>)
+  ->Name("keccak-p[1600, 12] scalar batch=2")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_scalar_batch<12, 4>)
+  ->Name("keccak-p[1600, 12] scalar batch=4")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_scalar_batch<24, 1>)
+  ->Name("keccak-p[1600, 24] scalar batch=1")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_scalar_batch<24, 2>)
+  ->Name("keccak-p[1600, 24] scalar batch=2")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_scalar_batch<24, 4>)
+  ->Name("keccak-p[1600, 24] scalar batch=4")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_x2<12>)->Name("keccak-p[1600, 12] x2")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_x2<24>)->Name("keccak-p[1600, 24] x2")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_x4<12>)->Name("keccak-p[1600, 12] x4")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_x4<24>)->Name("keccak-p[1600, 24] x4")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_x8<12>)->Name("keccak-p[1600, 12] x8")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_keccak_permutation_x8<24>)->Name("keccak-p[1600, 24] x8")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
@@ -1,10 +1,18 @@
 #include "bench_common.hpp"
+#include "sha3/kt128.hpp"
+#include "sha3/kt256.hpp"
+#include "sha3/parallelhash128.hpp"
+#include "sha3/parallelhash256.hpp"
 #include "sha3/shake128.hpp"
 #include "sha3/shake256.hpp"
 #include "sha3/turboshake128.hpp"
 #include "sha3/turboshake256.hpp"
+#include <algorithm>
+#include <array>
 #include <benchmark/benchmark.h>
 #include <cstdint>
+#include <span>
+#include <vector>
 
 namespace {
 
@@ -156,6 +164,374 @@ bench_turboshake256(benchmark::State& state)
 #endif
 }
 
+/**
+ * Benchmarks expansion of a matrix or vector of `entry_cnt` entries, as done by lattice based schemes, where each entry is `nblocks` blocks, squeezed out of
+ * its own XOF instance, which absorbs a `seed_len` -byte seed, ending with two index bytes. When `x4` is set, entries are expanded four at a time, using
+ * `xof_x4_t`, with unused lanes of the last group of four recomputing its last entry. Otherwise each entry is expanded using `xof_t`.
+ */
+template<typename xof_t, typename xof_x4_t, size_t seed_len, size_t entry_cnt, size_t nblocks, bool x4>
+void
+bench_matrix_expansion(benchmark::State& state)
+{
+  constexpr size_t entry_byte_len = nblocks * xof_x4_t::BLOCK_BYTE_LEN;
+
+  std::vector<uint8_t> seeds(entry_cnt * seed_len);
+  generate_random_data<uint8_t>(seeds);
+
+  for (size_t i = 0; i < entry_cnt; i++) {
+    seeds[(i * seed_len) + seed_len - 2] = static_cast<uint8_t>(i % 8);
+    seeds[(i * seed_len) + seed_len - 1] = static_cast<uint8_t>(i / 8);
+  }
+
+  std::vector<uint8_t> out(entry_cnt * entry_byte_len);
+  std::array<uint8_t, entry_byte_len> scratch{};
+
+  const auto seed_at = [&](const size_t i) { return std::span(seeds).subspan(std::min(i, entry_cnt - 1) * seed_len, seed_len); };
+  const auto out_at = [&](const size_t i) { return (i < entry_cnt) ? std::span(out).subspan(i * entry_byte_len, entry_byte_len) : std::span(scratch); };
+
+  for (auto _ : state) {
+    if constexpr (x4) {
+      for (size_t i = 0; i < entry_cnt; i += xof_x4_t::INSTANCE_CNT) {
+        xof_x4_t hasher;
+        hasher.absorb(seed_at(i), seed_at(i + 1), seed_at(i + 2), seed_at(i + 3));
+        hasher.finalize();
+        hasher.squeezeblocks(out_at(i), out_at(i + 1), out_at(i + 2), out_at(i + 3), nblocks);
+
+        benchmark::DoNotOptimize(hasher);
+      }
+    } else {
+      for (size_t i = 0; i < entry_cnt; i++) {
+        xof_t hasher;
+        hasher.absorb(seed_at(i));
+        hasher.finalize();
+        hasher.squeeze(out_at(i));
+
+        benchmark::DoNotOptimize(hasher);
+      }
+    }
+
+    benchmark::DoNotOptimize(seeds);
+    benchmark::DoNotOptimize(out);
+    benchmark::ClobberMemory();
+  }
+
+  const size_t bytes_processed = state.iterations() * (seeds.size() + out.size());
+  state.SetBytesProcessed(static_cast<int64_t>(bytes_processed));
+
+#ifdef CYCLES_PER_BYTE
+  state.counters["CYCLES/ BYTE"] = state.counters["CYCLES"] / static_cast<double>(bytes_processed);
+#endif
+}
+
+// ML-KEM-768 matrix A : 3 x 3 entries, each 3 SHAKE128 blocks, out of 32 -byte seed ρ and two indices.
+template<bool x4>
+void
+bench_ml_kem_768_matrix(benchmark::State& state)
+{
+  bench_matrix_expansion<shake128::shake128_t, shake128::shake128_x4_t, 34, 9, 3, x4>(state);
+}
+
+// ML-DSA-65 matrix A : 6 x 5 entries, each 5 SHAKE128 blocks, out of 32 -byte seed ρ and two indices.
+template<bool x4>
+void
+bench_ml_dsa_65_matrix(benchmark::State& state)
+{
+  bench_matrix_expansion<shake128::shake128_t, shake128::shake128_x4_t, 34, 30, 5, x4>(state);
+}
+
+// ML-DSA-65 secret vectors s1 and s2 : 5 + 6 entries, each 2 SHAKE256 blocks, out of 64 -byte seed ρ' and a two -byte nonce.
+template<bool x4>
+void
+bench_ml_dsa_65_secret_vectors(benchmark::State& state)
+{
+  bench_matrix_expansion<shake256::shake256_t, shake256::shake256_x4_t, 66, 11, 2, x4>(state);
+}
+
+/**
+ * Benchmarks squeezing `olen` -bytes out of SHAKE128, `piece_len` -bytes at a time, as rejection samplers do, either by calling `squeeze` for each piece or,
+ * when `buffered` is set, by reading each piece through a buffered reader.
+ */
+template<size_t piece_len, bool buffered>
+void
+bench_shake128_tiny_squeezes(benchmark::State& state)
+{
+  const auto olen = static_cast<size_t>(state.range(0));
+
+  std::array<uint8_t, 32> msg{};
+  std::vector<uint8_t> out(olen - (olen % piece_len));
+
+  generate_random_data<uint8_t>(msg);
+
+  for (auto _ : state) {
+    shake128::shake128_t hasher;
+    hasher.absorb(msg);
+    hasher.finalize();
+
+    auto out_span = std::span(out);
+
+    if constexpr (buffered) {
+      shake128::reader_t<> reader(hasher);
+      for (size_t off = 0; off < out.size(); off += piece_len) {
+        reader.read(out_span.subspan(off, piece_len));
+      }
+    } else {
+      for (size_t off = 0; off < out.size(); off += piece_len) {
+        hasher.squeeze(out_span.subspan(off, piece_len));
+      }
+    }
+
+    benchmark::DoNotOptimize(hasher);
+    benchmark::DoNotOptimize(out);
+    benchmark::ClobberMemory();
+  }
+
+  const size_t bytes_processed = state.iterations() * (msg.size() + out.size());
+  state.SetBytesProcessed(static_cast<int64_t>(bytes_processed));
+
+#ifdef CYCLES_PER_BYTE
+  state.counters["CYCLES/ BYTE"] = state.counters["CYCLES"] / static_cast<double>(bytes_processed);
+#endif
+}
+
+/**
+ * Benchmarks sampling `len` values uniform in [0, q), out of SHAKE128 output of a 34 -byte seed, as done while expanding public matrices of ML-KEM
+ * ( q = 3329 ) and ML-DSA ( q = 8380417 ). Uses `shake128::sample_uniform`, when `vectorized` is set, otherwise the usual hand-written loop, squeezing 3
+ * -bytes at a time.
+ */
+template<uint32_t q, typename T, bool vectorized>
+void
+bench_shake128_sample_uniform(benchmark::State& state)
+{
+  const auto len = static_cast<size_t>(state.range(0));
+
+  std::array<uint8_t, 34> seed{};
+  std::vector<T> out(len);
+
+  generate_random_data<uint8_t>(seed);
+
+  for (auto _ : state) {
+    shake128::shake128_t hasher;
+    hasher.absorb(seed);
+    hasher.finalize();
+
+    if constexpr (vectorized) {
+      shake128::sample_uniform<q>(hasher, std::span(out));
+    } else {
+      size_t ctr = 0;
+      while (ctr < len) {
+        std::array<uint8_t, 3> chunk{};
+        hasher.squeeze(chunk);
+
+        if constexpr (q <= 4096) {
+          const auto cand0 = static_cast<uint32_t>(chunk[0] | ((chunk[1] & 0x0fU) << 8U));
+          const auto cand1 = static_cast<uint32_t>((chunk[1] >> 4U) | (static_cast<uint32_t>(chunk[2]) << 4U));
+
+          if (cand0 < q) {
+            out[ctr++] = static_cast<T>(cand0);
+          }
+          if ((cand1 < q) && (ctr < len)) {
+            out[ctr++] = static_cast<T>(cand1);
+          }
+        } else {
+          const auto cand = static_cast<uint32_t>(chunk[0] | (chunk[1] << 8U) | ((chunk[2] & 0x7fU) << 16U));
+          if (cand < q) {
+            out[ctr++] = static_cast<T>(cand);
+          }
+        }
+      }
+    }
+
+    benchmark::DoNotOptimize(hasher);
+    benchmark::DoNotOptimize(out);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * len));
+}
+
+/**
+ * Benchmarks advancing `chain_cnt` hash chains, over `value_len` -byte values, by 0 to 15 steps each, as done while signing or verifying a W-OTS+ like one-time
+ * signature, with Winternitz parameter w = 16. Uses `shake256::advance_chains`, when `multi_buffer` is set, otherwise iterates SHAKE256 on each chain.
+ */
+template<size_t value_len, size_t chain_cnt, bool multi_buffer>
+void
+bench_shake256_hash_chains(benchmark::State& state)
+{
+  std::vector<std::array<uint8_t, value_len>> values(chain_cnt);
+  std::vector<size_t> steps(chain_cnt);
+  size_t total_steps = 0;
+
+  for (size_t i = 0; i < chain_cnt; i++) {
+    generate_random_data<uint8_t>(values[i]);
+    steps[i] = (i * 7) % 16;
+    total_steps += steps[i];
+  }
+
+  for (auto _ : state) {
+    if constexpr (multi_buffer) {
+      shake256::advance_chains(std::span(values), std::span<const size_t>(steps));
+    } else {
+      for (size_t i = 0; i < chain_cnt; i++) {
+        for (size_t step = 0; step < steps[i]; step++) {
+          shake256::shake256_t hasher;
+          hasher.absorb(values[i]);
+          hasher.finalize();
+          hasher.squeeze(values[i]);
+        }
+      }
+    }
+
+    benchmark::DoNotOptimize(values);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * total_steps));
+}
+
+/**
+ * Benchmarks one-shot KT128 on `mlen` -byte input, squeezing 32 -bytes, with leaves spread across a pool of `thread_cnt` threads, which is created once,
+ * outside of the timed loop.
+ */
+void
+bench_kt128(benchmark::State& state)
+{
+  const auto mlen = static_cast<size_t>(state.range(0));
+  const auto thread_cnt = static_cast<size_t>(state.range(1));
+
+  std::vector<uint8_t> msg(mlen);
+  std::array<uint8_t, 32> out{};
+
+  generate_random_data<uint8_t>(msg);
+
+  kt128::thread_pool_t pool(thread_cnt);
+
+  for (auto _ : state) {
+    kt128::hash(msg, {}, out, pool);
+
+    benchmark::DoNotOptimize(msg);
+    benchmark::DoNotOptimize(out);
+    benchmark::ClobberMemory();
+  }
+
+  const size_t bytes_processed = state.iterations() * msg.size();
+  state.SetBytesProcessed(static_cast<int64_t>(bytes_processed));
+
+#ifdef CYCLES_PER_BYTE
+  state.counters["CYCLES/ BYTE"] = state.counters["CYCLES"] / static_cast<double>(bytes_processed);
+#endif
+}
+
+// Same as `bench_kt128`, but for KT256, squeezing 64 -bytes.
+void
+bench_kt256(benchmark::State& state)
+{
+  const auto mlen = static_cast<size_t>(state.range(0));
+  const auto thread_cnt = static_cast<size_t>(state.range(1));
+
+  std::vector<uint8_t> msg(mlen);
+  std::array<uint8_t, 64> out{};
+
+  generate_random_data<uint8_t>(msg);
+
+  kt256::thread_pool_t pool(thread_cnt);
+
+  for (auto _ : state) {
+    kt256::hash(msg, {}, out, pool);
+
+    benchmark::DoNotOptimize(msg);
+    benchmark::DoNotOptimize(out);
+    benchmark::ClobberMemory();
+  }
+
+  const size_t bytes_processed = state.iterations() * msg.size();
+  state.SetBytesProcessed(static_cast<int64_t>(bytes_processed));
+
+#ifdef CYCLES_PER_BYTE
+  state.counters["CYCLES/ BYTE"] = state.counters["CYCLES"] / static_cast<double>(bytes_processed);
+#endif
+}
+
+/**
+ * Benchmarks incremental KT128 on `mlen` -byte input, arriving in 64 KiB pieces, as read from a pipe or socket, with full leaves hashed on a pool of
+ * `thread_cnt` threads, while rest of the input is being absorbed.
+ */
+void
+bench_kt128_stream(benchmark::State& state)
+{
+  constexpr size_t PIECE_LEN = 64 * 1024;
+
+  const auto mlen = static_cast<size_t>(state.range(0));
+  const auto thread_cnt = static_cast<size_t>(state.range(1));
+
+  std::vector<uint8_t> msg(mlen);
+  std::array<uint8_t, 32> out{};
+
+  generate_random_data<uint8_t>(msg);
+
+  kt128::thread_pool_t pool(thread_cnt);
+  kt128::kt128_t hasher(pool);
+
+  for (auto _ : state) {
+    for (size_t off = 0; off < mlen; off += PIECE_LEN) {
+      hasher.absorb(std::span(msg).subspan(off, std::min(PIECE_LEN, mlen - off)));
+    }
+
+    hasher.finalize();
+    hasher.squeeze(out);
+    hasher.reset();
+
+    benchmark::DoNotOptimize(msg);
+    benchmark::DoNotOptimize(out);
+    benchmark::ClobberMemory();
+  }
+
+  const size_t bytes_processed = state.iterations() * msg.size();
+  state.SetBytesProcessed(static_cast<int64_t>(bytes_processed));
+
+#ifdef CYCLES_PER_BYTE
+  state.counters["CYCLES/ BYTE"] = state.counters["CYCLES"] / static_cast<double>(bytes_processed);
+#endif
+}
+
+/**
+ * Benchmarks ParallelHash128 or ParallelHash256, picked by `security_level`, on `mlen` -byte input, split into `block_len` -byte blocks, hashed in lanes of
+ * multi-buffer permutation, across a pool of `thread_cnt` threads.
+ */
+template<size_t security_level>
+void
+bench_parallelhash(benchmark::State& state)
+{
+  const auto mlen = static_cast<size_t>(state.range(0));
+  const auto block_len = static_cast<size_t>(state.range(1));
+  const auto thread_cnt = static_cast<size_t>(state.range(2));
+
+  std::vector<uint8_t> msg(mlen);
+  std::array<uint8_t, security_level / 4> out{};
+
+  generate_random_data<uint8_t>(msg);
+
+  sha3_utils::thread_pool_t pool(thread_cnt);
+
+  for (auto _ : state) {
+    if constexpr (security_level == parallelhash128::TARGET_BIT_SECURITY_LEVEL) {
+      parallelhash128::hash(msg, block_len, {}, out, pool);
+    } else {
+      parallelhash256::hash(msg, block_len, {}, out, pool);
+    }
+
+    benchmark::DoNotOptimize(msg);
+    benchmark::DoNotOptimize(out);
+    benchmark::ClobberMemory();
+  }
+
+  const size_t bytes_processed = state.iterations() * msg.size();
+  state.SetBytesProcessed(static_cast<int64_t>(bytes_processed));
+
+#ifdef CYCLES_PER_BYTE
+  state.counters["CYCLES/ BYTE"] = state.counters["CYCLES"] / static_cast<double>(bytes_processed);
+#endif
+}
+
 }
 
 BENCHMARK(bench_shake128)
@@ -168,6 +544,16 @@ BENCHMARK(bench_shake256)
   ->Name("shake256")
   ->ComputeStatistics("min", compute_min)
   ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_shake128)
+  ->ArgsProduct({ { 32 }, benchmark::CreateRange(4096, 1 << 20, 16) })
+  ->Name("shake128 keystream")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_shake256)
+  ->ArgsProduct({ { 32 }, benchmark::CreateRange(4096, 1 << 20, 16) })
+  ->Name("shake256 keystream")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
 BENCHMARK(bench_turboshake128)
   ->ArgsProduct({ benchmark::CreateRange(64, 16384, 4), { 64 } })
   ->Name("turboshake128")
@@ -178,3 +564,133 @@ BENCHMARK(bench_turboshake256)
   ->Name("turboshake256")
   ->ComputeStatistics("min", compute_min)
   ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_ml_kem_768_matrix<false>)
+  ->Name("ml-kem-768 matrix A/ shake128")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_ml_kem_768_matrix<true>)
+  ->Name("ml-kem-768 matrix A/ shake128 x4")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_ml_dsa_65_matrix<false>)
+  ->Name("ml-dsa-65 matrix A/ shake128")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_ml_dsa_65_matrix<true>)
+  ->Name("ml-dsa-65 matrix A/ shake128 x4")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_ml_dsa_65_secret_vectors<false>)
+  ->Name("ml-dsa-65 s1, s2/ shake256")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_ml_dsa_65_secret_vectors<true>)
+  ->Name("ml-dsa-65 s1, s2/ shake256 x4")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_shake128_tiny_squeezes<1, false>)
+  ->Arg(1344)
+  ->Name("shake128 1-byte squeeze")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_shake128_tiny_squeezes<1, true>)
+  ->Arg(1344)
+  ->Name("shake128 1-byte reader")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_shake128_tiny_squeezes<2, false>)
+  ->Arg(1344)
+  ->Name("shake128 2-byte squeeze")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_shake128_tiny_squeezes<2, true>)
+  ->Arg(1344)
+  ->Name("shake128 2-byte reader")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_shake128_tiny_squeezes<3, false>)
+  ->Arg(1344)
+  ->Name("shake128 3-byte squeeze")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_shake128_tiny_squeezes<3, true>)
+  ->Arg(1344)
+  ->Name("shake128 3-byte reader")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_shake128_sample_uniform<3329, uint16_t, false>)
+  ->Arg(256)
+  ->Name("shake128 ml-kem q=3329 byte loop")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_shake128_sample_uniform<3329, uint16_t, true>)
+  ->Arg(256)
+  ->Name("shake128 ml-kem q=3329 sample_uniform")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_shake128_sample_uniform<8380417, uint32_t, false>)
+  ->Arg(256)
+  ->Name("shake128 ml-dsa q=8380417 byte loop")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_shake128_sample_uniform<8380417, uint32_t, true>)
+  ->Arg(256)
+  ->Name("shake128 ml-dsa q=8380417 sample_uniform")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_shake256_hash_chains<16, 35, false>)
+  ->Name("shake256 w-ots n=16 chain loop")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_shake256_hash_chains<16, 35, true>)
+  ->Name("shake256 w-ots n=16 advance_chains")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_shake256_hash_chains<32, 67, false>)
+  ->Name("shake256 w-ots n=32 chain loop")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_shake256_hash_chains<32, 67, true>)
+  ->Name("shake256 w-ots n=32 advance_chains")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_turboshake128)
+  ->ArgsProduct({ { 1 << 20, 64 << 20 }, { 32 } })
+  ->Name("turboshake128")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_kt128)
+  ->ArgsProduct({ { 1 << 20, 64 << 20 }, { 1, 2, 4, 8 } })
+  ->Name("kt128")
+  ->UseRealTime()
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_turboshake256)
+  ->ArgsProduct({ { 1 << 20, 64 << 20, 1 << 30 }, { 64 } })
+  ->Name("turboshake256")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_kt256)
+  ->ArgsProduct({ { 1 << 20, 64 << 20, 1 << 30 }, { 1, 2, 4, 8 } })
+  ->Name("kt256")
+  ->UseRealTime()
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_kt128_stream)
+  ->ArgsProduct({ { 64 << 20 }, { 1, 2, 4, 8 } })
+  ->Name("kt128 stream")
+  ->UseRealTime()
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_parallelhash<128>)
+  ->ArgsProduct({ { 1 << 20, 64 << 20 }, { 1024, 8192 }, { 1, 2, 4, 8 } })
+  ->Name("parallelhash128")
+  ->UseRealTime()
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_parallelhash<256>)
+  ->ArgsProduct({ { 1 << 20, 64 << 20 }, { 1024, 8192 }, { 1, 2, 4, 8 } })
+  ->Name("parallelhash256")
+  ->UseRealTime()
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
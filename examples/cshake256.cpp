@@ -0,0 +1,40 @@
+#include "sha3/cshake256.hpp"
+#include "example_helper.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <string_view>
+#include <vector>
+
+// Compile it using
+//
+// g++ -std=c++20 -Wall -O3 -march=native -I include examples/cshake256.cpp
+int
+main()
+{
+  constexpr size_t msg_len = 32;
+  constexpr size_t out_len = 72;
+  constexpr std::string_view customization_str = "Email Signature";
+
+  std::vector<uint8_t> msg(msg_len, 0);
+  std::iota(msg.begin(), msg.end(), 0);
+
+  const std::vector<uint8_t> customization(customization_str.begin(), customization_str.end());
+  std::vector<uint8_t> out(out_len, 0);
+
+  // Create cSHAKE256 hasher, with empty function name and a customization string, which are absorbed right away
+  cshake256::cshake256_t hasher({}, customization);
+
+  hasher.absorb(msg);
+  hasher.finalize();
+  hasher.squeeze(out);
+
+  std::cout << "cSHAKE256\n\n";
+  std::cout << "Message       : " << to_hex(msg) << "\n";
+  std::cout << "Customization : " << to_hex(customization) << "\n";
+  std::cout << "Output        : " << to_hex(out) << "\n";
+
+  return EXIT_SUCCESS;
+}
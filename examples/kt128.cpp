@@ -0,0 +1,47 @@
+#include "sha3/kt128.hpp"
+#include "example_helper.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Compile it using
+//
+// g++ -std=c++20 -Wall -O3 -march=native -I include examples/kt128.cpp -lpthread
+int
+main()
+{
+  constexpr size_t msg_len = 32;
+  constexpr size_t out_len = 40;
+  constexpr std::string_view customization_str = "example";
+
+  std::vector<uint8_t> msg(msg_len, 0);
+  std::iota(msg.begin(), msg.end(), 0);
+
+  const std::vector<uint8_t> customization(customization_str.begin(), customization_str.end());
+  std::vector<uint8_t> out(out_len, 0);
+
+  // Short message fits in a single chunk, so it is hashed by a single TurboSHAKE128 call
+  kt128::hash(msg, customization, out);
+
+  std::cout << "KT128\n\n";
+  std::cout << "Message       : " << to_hex(msg) << "\n";
+  std::cout << "Customization : " << to_hex(customization) << "\n";
+  std::cout << "Output        : " << to_hex(out) << "\n";
+
+  // Long message is hashed as a tree of 8 KiB leaves, spread across threads of a pool, which can be reused across calls
+  std::vector<uint8_t> long_msg(1UL << 20, 0);
+  std::iota(long_msg.begin(), long_msg.end(), 0);
+
+  kt128::thread_pool_t pool(4);
+  kt128::hash(long_msg, customization, out, pool);
+
+  std::cout << "\nMessage       : 1 MiB\n";
+  std::cout << "Output        : " << to_hex(out) << "\n";
+
+  return EXIT_SUCCESS;
+}
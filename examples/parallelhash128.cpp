@@ -0,0 +1,47 @@
+#include "sha3/parallelhash128.hpp"
+#include "example_helper.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Compile it using
+//
+// g++ -std=c++20 -Wall -O3 -march=native -I include examples/parallelhash128.cpp -lpthread
+int
+main()
+{
+  constexpr size_t msg_len = 1UL << 20;
+  constexpr size_t block_len = 8192;
+  constexpr size_t out_len = 32;
+  constexpr std::string_view customization_str = "example";
+
+  std::vector<uint8_t> msg(msg_len, 0);
+  std::iota(msg.begin(), msg.end(), 0);
+
+  const std::vector<uint8_t> customization(customization_str.begin(), customization_str.end());
+  std::vector<uint8_t> out(out_len, 0);
+
+  // Message is split into 8 KiB blocks, which are hashed in lanes of multi-buffer permutation, spread across threads of a pool, which can be reused
+  parallelhash128::thread_pool_t pool(4);
+  parallelhash128::hash(msg, block_len, customization, out, pool);
+
+  std::cout << "ParallelHash128\n\n";
+  std::cout << "Message       : 1 MiB\n";
+  std::cout << "Block length  : " << block_len << "\n";
+  std::cout << "Customization : " << to_hex(customization) << "\n";
+  std::cout << "Output        : " << to_hex(out) << "\n";
+
+  // XOF variant doesn't bind output length, so any output is a prefix of a longer one
+  std::vector<uint8_t> xof_out(2 * out_len, 0);
+  parallelhash128::xof(msg, block_len, customization, xof_out, pool);
+
+  std::cout << "\nParallelHashXOF128\n\n";
+  std::cout << "Output        : " << to_hex(xof_out) << "\n";
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include "sha3/internals/cshake.hpp"
+#include "sha3/shake128.hpp"
+#include <cstddef>
+
+// Customizable SHAKE128 ( cSHAKE128 ) eXtendable Output Function : Keccak[256](bytepad(encode_string(N) || encode_string(S), 1344/ 8) || X || 00, L)
+namespace cshake128 {
+
+// Number of rounds keccak-p[1600] is applied.
+static constexpr size_t NUM_KECCAK_ROUNDS = cshake::NUM_KECCAK_ROUNDS;
+
+// cSHAKE128 XOF offers at max 128-bits of security.
+static constexpr size_t TARGET_BIT_SECURITY_LEVEL = shake128::TARGET_BIT_SECURITY_LEVEL;
+
+// Width of rate portion of the sponge, in bits.
+static constexpr size_t RATE = shake128::RATE;
+
+/**
+ * cSHAKE128 eXtendable Output Function (XOF), created with function name N and customization string S, either of which can be empty. With both of them
+ * empty, it is same as SHAKE128. See `cshake::cshake_t`.
+ *
+ * See cSHAKE definition in section 3 of SP 800-185 https://doi.org/10.6028/NIST.SP.800-185.
+ */
+using cshake128_t = cshake::cshake_t<RATE>;
+
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include "sha3/internals/cpu_features.hpp"
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <string_view>
+
+// Runtime selection of the backend, powering Keccak-p[1600] permutation and absorb/ squeeze loops of the sponge
+namespace keccak {
+
+// Compiled backends of Keccak-p[1600] permutation.
+enum class backend_t : uint8_t
+{
+  scalar,    // Portable implementation, which is the bit-interleaved one on 32 -bit targets, see `keccak::BIT_INTERLEAVED`.
+  bmi,       // Portable 64 -bit implementation, compiled with BMI1 and BMI2 enabled, so that χ uses `andn` and ρ uses `rorx`.
+  avx2,      // Single-state AVX2 implementation, see keccak_avx2.hpp.
+  avx512,    // Single-state AVX-512 implementation, see keccak_avx512.hpp.
+  neon_sha3, // Single-state AArch64 implementation, using ARMv8.2 SHA3 extension instructions, see keccak_neon_sha3.hpp.
+};
+
+// All compiled backends of Keccak-p[1600] permutation.
+static constexpr std::array<backend_t, 5> BACKENDS{ backend_t::scalar, backend_t::bmi, backend_t::avx2, backend_t::avx512, backend_t::neon_sha3 };
+
+// Returns true iff the CPU, executing this program, can run the requested backend.
+inline bool
+is_backend_supported(const backend_t backend)
+{
+  switch (backend) {
+    case backend_t::scalar:
+      return true;
+    case backend_t::bmi:
+      return cpu_features::has_bmi();
+    case backend_t::avx2:
+      return cpu_features::has_avx2();
+    case backend_t::avx512:
+      return cpu_features::has_avx512f();
+    case backend_t::neon_sha3:
+      return cpu_features::has_sha3();
+  }
+
+  return false;
+}
+
+// Returns human-readable name of the backend, which is useful for logging and telemetry.
+constexpr std::string_view
+backend_name(const backend_t backend)
+{
+  switch (backend) {
+    case backend_t::scalar:
+      return "scalar";
+    case backend_t::bmi:
+      return "bmi";
+    case backend_t::avx2:
+      return "avx2";
+    case backend_t::avx512:
+      return "avx512";
+    case backend_t::neon_sha3:
+      return "neon_sha3";
+  }
+
+  return "unknown";
+}
+
+/**
+ * Backends, requiring instruction set extensions, in order of preference. Single-state Keccak-p[1600] permutation is a long dependency chain of 64 -bit
+ * operations, which wide scalar cores execute well, once `andn` and the non-destructive `rorx` are available. On measured x86-64 hosts, BMI backend
+ * turns out to be faster than the single-state AVX-512 one, which itself is faster than the AVX2 one, so the SIMD backends are only picked on CPUs
+ * lacking BMI. On AArch64, the SHA3 extension backend is the only one, as fused `eor3`, `rax1`, `xar` and `bcax` instructions do the work of two or three
+ * scalar ones each.
+ */
+static constexpr std::array<backend_t, 4> PREFERRED_BACKENDS{ backend_t::bmi, backend_t::avx512, backend_t::avx2, backend_t::neon_sha3 };
+
+/**
+ * Returns the backend, powering Keccak-p[1600] permutation and absorb/ squeeze loops of the sponge, on the CPU executing this program. It is the first
+ * supported one from `PREFERRED_BACKENDS`, else the scalar one, unless environment variable `SHA3_BACKEND` names a supported backend, see `backend_name`.
+ *
+ * CPU features are queried only once, on first call, and the result is cached.
+ */
+inline backend_t
+active_backend()
+{
+  static const backend_t backend = []() {
+    if (const char* requested = std::getenv("SHA3_BACKEND"); requested != nullptr) {
+      for (const auto candidate : BACKENDS) {
+        if ((backend_name(candidate) == requested) && is_backend_supported(candidate)) {
+          return candidate;
+        }
+      }
+    }
+
+    for (const auto candidate : PREFERRED_BACKENDS) {
+      if (is_backend_supported(candidate)) {
+        return candidate;
+      }
+    }
+
+    return backend_t::scalar;
+  }();
+
+  return backend;
+}
+
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+// SIMD backends of Keccak-p[1600] permutation are compiled using per-function target attributes, so that they are available even when the translation
+// unit itself is not compiled with `-mavx2` or `-march=native`. Which one to use is decided by querying CPU features, at runtime.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SHA3_HAS_X86_64_SIMD_BACKENDS
+#define SHA3_TARGET_BMI __attribute__((target("bmi,bmi2")))
+#define SHA3_TARGET_AVX2 __attribute__((target("avx2")))
+#define SHA3_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+// Same holds for the ARMv8.2 SHA3 extension backend, on AArch64 Linux, where the extension is detected using `getauxval(AT_HWCAP)`.
+#if defined(__aarch64__) && defined(__linux__) && (defined(__GNUC__) || defined(__clang__))
+#define SHA3_HAS_AARCH64_SHA3_BACKEND
+#if defined(__clang__)
+#define SHA3_TARGET_SHA3 __attribute__((target("sha3")))
+#else
+#define SHA3_TARGET_SHA3 __attribute__((target("+sha3")))
+#endif
+#include <sys/auxv.h>
+#endif
+
+// Whether any backend, requiring instruction set extensions, is compiled in, so that Keccak-p[1600] permutation and sponge loops are dispatched at runtime.
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS) || defined(SHA3_HAS_AARCH64_SHA3_BACKEND)
+#define SHA3_HAS_SIMD_BACKENDS
+#endif
+
+// Runtime detection of CPU features, used for selecting the best available backend of Keccak-p[1600] permutation.
+namespace cpu_features {
+
+// Returns true iff the CPU, executing this program, supports both BMI1 and BMI2 instructions. Result is computed only once and cached.
+inline bool
+has_bmi()
+{
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+  static const bool supported = []() {
+    __builtin_cpu_init();
+    return (__builtin_cpu_supports("bmi") != 0) && (__builtin_cpu_supports("bmi2") != 0);
+  }();
+
+  return supported;
+#else
+  return false;
+#endif
+}
+
+// Returns true iff the CPU, executing this program, supports AVX2 instructions. Result is computed only once and cached.
+inline bool
+has_avx2()
+{
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+  static const bool supported = []() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+  }();
+
+  return supported;
+#else
+  return false;
+#endif
+}
+
+// Returns true iff the CPU, executing this program, supports AVX-512 Foundation instructions and the OS preserves ZMM registers. Result is cached.
+inline bool
+has_avx512f()
+{
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+  static const bool supported = []() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f") != 0;
+  }();
+
+  return supported;
+#else
+  return false;
+#endif
+}
+
+// Returns true iff the CPU, executing this program, supports ARMv8.2 SHA3 extension instructions i.e. EOR3, RAX1, XAR and BCAX, as reported by the kernel.
+// Result is computed only once and cached.
+inline bool
+has_sha3()
+{
+#if defined(SHA3_HAS_AARCH64_SHA3_BACKEND)
+#if !defined(HWCAP_SHA3)
+  constexpr unsigned long HWCAP_SHA3 = 1UL << 17U;
+#endif
+
+  static const bool supported = (getauxval(AT_HWCAP) & HWCAP_SHA3) != 0;
+  return supported;
+#else
+  return false;
+#endif
+}
+
+}
@@ -0,0 +1,189 @@
+#pragma once
+#include "sha3/internals/force_inline.hpp"
+#include "sha3/internals/keccak.hpp"
+#include "sha3/internals/sponge.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+// Customizable SHAKE ( cSHAKE ) and its integer encodings, as specified in NIST SP 800-185 https://doi.org/10.6028/NIST.SP.800-185
+namespace cshake {
+
+// cSHAKE is built on Keccak-p[1600, 24] permutation, same as SHAKE.
+static constexpr size_t NUM_KECCAK_ROUNDS = keccak::MAX_NUM_ROUNDS;
+
+// Domain separator bits 00, used for finalization, when function name or customization string is non-empty.
+static constexpr uint8_t DOM_SEP = 0b00000000;
+static constexpr size_t DOM_SEP_BW = 2;
+
+// Domain separator bits 1111 of SHAKE, as cSHAKE with empty function name and customization string is SHAKE.
+static constexpr uint8_t SHAKE_DOM_SEP = 0b00001111;
+static constexpr size_t SHAKE_DOM_SEP_BW = std::bit_width(SHAKE_DOM_SEP);
+
+// Maximum byte length of `left_encode(x)` or `right_encode(x)`, for any x of type size_t.
+static constexpr size_t ENCODE_MAX_BYTE_LEN = sizeof(size_t) + 1;
+
+// Returns # -of bytes in big-endian encoding of `x`, with no leading zero byte, which is 1 for x = 0.
+static constexpr size_t
+encoded_byte_len(const size_t x)
+{
+  const size_t len = (static_cast<size_t>(std::bit_width(x)) + std::numeric_limits<uint8_t>::digits - 1) / std::numeric_limits<uint8_t>::digits;
+  return std::max<size_t>(len, 1);
+}
+
+/**
+ * Encodes `x` as a byte holding # -of bytes in big-endian encoding of `x`, followed by that encoding, as defined in section 2.3.1 of SP 800-185, writing it
+ * to `out`. Returns # -of bytes written.
+ */
+static constexpr size_t
+left_encode(const size_t x, std::span<uint8_t, ENCODE_MAX_BYTE_LEN> out)
+{
+  const size_t len = encoded_byte_len(x);
+
+  out[0] = static_cast<uint8_t>(len);
+  for (size_t i = 0; i < len; i++) {
+    out[i + 1] = static_cast<uint8_t>(x >> ((len - 1 - i) * std::numeric_limits<uint8_t>::digits));
+  }
+
+  return len + 1;
+}
+
+/**
+ * Encodes `x` as big-endian byte string, with no leading zero byte, followed by a byte holding length of that string, as defined in section 2.3.1 of
+ * SP 800-185, writing it to `out`. Returns # -of bytes written.
+ */
+static constexpr size_t
+right_encode(const size_t x, std::span<uint8_t, ENCODE_MAX_BYTE_LEN> out)
+{
+  const size_t len = encoded_byte_len(x);
+
+  for (size_t i = 0; i < len; i++) {
+    out[i] = static_cast<uint8_t>(x >> ((len - 1 - i) * std::numeric_limits<uint8_t>::digits));
+  }
+  out[len] = static_cast<uint8_t>(len);
+
+  return len + 1;
+}
+
+/**
+ * cSHAKE eXtendable Output Function, with rate of `num_bits_in_rate`, i.e. cSHAKE128 or cSHAKE256, offering usual `absorb() -> finalize() -> squeeze()`
+ * cycle.
+ *
+ * Function name N and customization string S are absorbed, as bytepad(encode_string(N) || encode_string(S), rate/ 8), once, in the constructor, and the
+ * resulting state is kept, s.t. `reset` doesn't need to absorb them again. When both of them are empty, it is same as SHAKE128 or SHAKE256.
+ *
+ * See cSHAKE definition in section 3 of SP 800-185 https://doi.org/10.6028/NIST.SP.800-185.
+ */
+template<size_t num_bits_in_rate>
+struct cshake_t
+{
+private:
+  static constexpr size_t num_bytes_in_rate = num_bits_in_rate / std::numeric_limits<uint8_t>::digits;
+
+  std::array<uint64_t, keccak::LANE_CNT> state{};
+  std::array<uint64_t, keccak::LANE_CNT> customized_state{}; // State, right after absorbing bytepad(encode_string(N) || encode_string(S), rate/ 8)
+  size_t offset = 0;
+  alignas(4) bool customized = false; // Function name or customization string non-empty ?
+  alignas(4) bool finalized = false;  // All message bytes absorbed ?
+  size_t squeezable = 0;
+
+  // Absorbs `x`, encoded using `left_encode`.
+  forceinline void absorb_left_encoded(const size_t x)
+  {
+    std::array<uint8_t, ENCODE_MAX_BYTE_LEN> encoded{};
+    const size_t encoded_len = left_encode(x, encoded);
+
+    sponge::absorb<num_bits_in_rate, NUM_KECCAK_ROUNDS>(state, offset, std::span<const uint8_t>(encoded).first(encoded_len));
+  }
+
+  // Absorbs encode_string(`str`) = left_encode(bit length of `str`) || `str`.
+  forceinline void absorb_encoded_string(std::span<const uint8_t> str)
+  {
+    absorb_left_encoded(str.size() * std::numeric_limits<uint8_t>::digits);
+    sponge::absorb<num_bits_in_rate, NUM_KECCAK_ROUNDS>(state, offset, str);
+  }
+
+public:
+  // Creates cSHAKE instance, with empty function name and customization string, which is same as SHAKE.
+  forceinline constexpr cshake_t() = default;
+
+  // Creates cSHAKE instance, with function name `function_name` and customization string `customization`, either of which can be empty.
+  cshake_t(std::span<const uint8_t> function_name, std::span<const uint8_t> customization)
+    : customized(!function_name.empty() || !customization.empty())
+  {
+    if (!customized) {
+      return;
+    }
+
+    absorb_left_encoded(num_bytes_in_rate);
+    absorb_encoded_string(function_name);
+    absorb_encoded_string(customization);
+
+    // Zero padding, up to next multiple of `rate/ 8` -bytes, only leaves a permutation to be applied.
+    if (offset > 0) {
+      keccak::permute<NUM_KECCAK_ROUNDS>(state);
+      offset = 0;
+    }
+
+    customized_state = state;
+  }
+
+  [[nodiscard]] forceinline constexpr size_t squeezable_num_bytes() const { return squeezable; }
+
+  /**
+   * Given N -many bytes input message, this routine consumes those into sponge state. Can be called any number of times, until `finalize` is called, after
+   * which it doesn't do anything.
+   */
+  forceinline constexpr void absorb(std::span<const uint8_t> msg)
+  {
+    if (!finalized) {
+      sponge::absorb<num_bits_in_rate, NUM_KECCAK_ROUNDS>(state, offset, msg);
+    }
+  }
+
+  /**
+   * After consuming arbitrary many input bytes, this routine is invoked when no more input bytes remaining to be consumed, making the sponge ready for
+   * squeezing. Calling it again doesn't do anything.
+   */
+  forceinline constexpr void finalize()
+  {
+    if (finalized) {
+      return;
+    }
+
+    if (customized) {
+      sponge::finalize<DOM_SEP, DOM_SEP_BW, num_bits_in_rate, NUM_KECCAK_ROUNDS>(state, offset);
+    } else {
+      sponge::finalize<SHAKE_DOM_SEP, SHAKE_DOM_SEP_BW, num_bits_in_rate, NUM_KECCAK_ROUNDS>(state, offset);
+    }
+
+    finalized = true;
+    squeezable = num_bytes_in_rate;
+  }
+
+  // After sponge state is finalized, arbitrary many output bytes can be squeezed by calling this function any number of times.
+  forceinline constexpr void squeeze(std::span<uint8_t> out)
+  {
+    if (finalized) {
+      sponge::squeeze<num_bits_in_rate, NUM_KECCAK_ROUNDS>(state, squeezable, out);
+    }
+  }
+
+  /**
+   * Resets the hasher to the state, right after absorbing function name and customization string, s.t. it can be used for another
+   * `absorb() -> finalize() -> squeeze()` cycle, with same function name and customization string.
+   */
+  forceinline constexpr void reset()
+  {
+    state = customized_state;
+    offset = 0;
+    finalized = false;
+    squeezable = 0;
+  }
+};
+
+}
@@ -0,0 +1,159 @@
+#pragma once
+#include "sha3/internals/cpu_features.hpp"
+#include "sha3/internals/force_inline.hpp"
+#include "sha3/internals/keccak.hpp"
+#include "sha3/internals/keccak_x4.hpp"
+#include "sha3/internals/keccak_x8.hpp"
+#include "sha3/internals/sponge.hpp"
+#include "sha3/internals/state_batch.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+// Iterated hashing of many independent hash chains, x = H(x), in lanes of multi-buffer Keccak-p[1600] permutation
+namespace sponge {
+
+/**
+ * Sets up Keccak-p[1600] permutation state for one step of a hash chain, over `value_len` -byte values, given `lane_at(i)`, which returns a reference to lane
+ * `i` of the state, holding the value of previous step in its first `value_len` -bytes. Same as resetting the state, absorbing the value and padding it, but
+ * the value is never serialized to bytes, it stays in the lanes.
+ */
+template<uint8_t domain_separator, size_t ds_bit_len, size_t num_bits_in_rate, size_t value_len, typename lane_at_t>
+static forceinline void
+prepare_chain_step(lane_at_t&& lane_at)
+{
+  constexpr size_t num_words_in_rate = num_bits_in_rate / std::numeric_limits<uint64_t>::digits;
+  constexpr size_t value_full_words = value_len / KECCAK_WORD_BYTE_LEN;
+  constexpr size_t value_tail_byte_len = value_len % KECCAK_WORD_BYTE_LEN;
+
+  // Padding, right after the value, along with the last padding bit, at the end of the rate portion.
+  constexpr uint8_t pad_byte = (1U << ds_bit_len) | (domain_separator & ((1U << ds_bit_len) - 1U));
+  constexpr uint64_t pad_word = static_cast<uint64_t>(pad_byte) << (value_tail_byte_len * std::numeric_limits<uint8_t>::digits);
+
+  if constexpr (value_tail_byte_len != 0) {
+    constexpr uint64_t value_tail_mask = (UINT64_C(1) << (value_tail_byte_len * std::numeric_limits<uint8_t>::digits)) - 1U;
+    lane_at(value_full_words) = (lane_at(value_full_words) & value_tail_mask) ^ pad_word;
+  } else {
+    lane_at(value_full_words) = pad_word;
+  }
+
+  for (size_t i = value_full_words + 1; i < keccak::LANE_CNT; i++) {
+    lane_at(i) = 0;
+  }
+
+  lane_at(num_words_in_rate - 1) ^= UINT64_C(0x80) << 56U;
+}
+
+/**
+ * Advances each of `values.size()` independent hash chains, over `value_len` -byte values, by `steps[i]` steps, in place, where each step is x = H(x), with
+ * H being the Keccak[c] based XOF, squeezing `value_len` -bytes. Chains get spread across `lane_cnt` lanes of multi-buffer Keccak-p[1600] permutation and, as
+ * soon as a chain completes, its lane takes the next chain, like `job_manager_t` does. Between steps, each chain value stays in lanes of the state, so a step
+ * costs little more than the permutation. The last chain, left alone, is finished on the scalar path.
+ *
+ * Output is same as hashing each value, on its own, `steps[i]` times.
+ */
+template<uint8_t domain_separator, size_t ds_bit_len, size_t num_bits_in_rate, size_t num_rounds, size_t value_len, size_t lane_cnt>
+static inline void
+advance_chains_using(std::span<std::array<uint8_t, value_len>> values, std::span<const size_t> steps)
+  requires(check_domain_separator(ds_bit_len) && (value_len > 0) && (value_len < num_bits_in_rate / std::numeric_limits<uint8_t>::digits) &&
+           ((lane_cnt == keccak::X4_STATE_CNT) || (lane_cnt == keccak::X8_STATE_CNT)))
+{
+  const size_t chain_cnt = std::min(values.size(), steps.size());
+
+  keccak::state_batch<lane_cnt> states{};
+
+  std::array<size_t, lane_cnt> chain_at{};
+  std::array<size_t, lane_cnt> remaining{};
+  size_t next_chain = 0;
+
+  while (true) {
+    // Lanes, whose chain is complete, take next chain, which needs at least one step.
+    for (size_t j = 0; j < lane_cnt; j++) {
+      if (remaining[j] > 0) {
+        continue;
+      }
+
+      while ((next_chain < chain_cnt) && (steps[next_chain] == 0)) {
+        next_chain++;
+      }
+      if (next_chain == chain_cnt) {
+        continue;
+      }
+
+      chain_at[j] = next_chain;
+      remaining[j] = steps[next_chain];
+      next_chain++;
+
+      states.store(j, {});
+      states.absorb_bytes(j, 0, values[chain_at[j]]);
+    }
+
+    const auto busy_lane_cnt = static_cast<size_t>(std::ranges::count_if(remaining, [](const size_t r) { return r > 0; }));
+    if (busy_lane_cnt == 0) {
+      break;
+    }
+
+    if (busy_lane_cnt == 1) {
+      // No more chains to refill lanes with, so the last one is finished on the scalar path.
+      const size_t j = static_cast<size_t>(std::ranges::find_if(remaining, [](const size_t r) { return r > 0; }) - remaining.begin());
+
+      std::array<uint64_t, keccak::LANE_CNT> state{};
+      states.load(j, state);
+
+      for (size_t step = 0; step < remaining[j]; step++) {
+        prepare_chain_step<domain_separator, ds_bit_len, num_bits_in_rate, value_len>([&](const size_t i) -> uint64_t& { return state[i]; });
+        keccak::permute<num_rounds>(state);
+      }
+
+      states.store(j, state);
+      states.squeeze_bytes(j, 0, values[chain_at[j]]);
+      remaining[j] = 0;
+      continue;
+    }
+
+    // All busy lanes take as many steps, in lockstep, as the one closest to completion needs. Idle lanes get permuted along, but are never read.
+    const size_t lockstep_cnt = std::ranges::min(remaining, {}, [](const size_t r) { return (r == 0) ? std::numeric_limits<size_t>::max() : r; });
+
+    for (size_t step = 0; step < lockstep_cnt; step++) {
+      for (size_t j = 0; j < lane_cnt; j++) {
+        prepare_chain_step<domain_separator, ds_bit_len, num_bits_in_rate, value_len>([&](const size_t i) -> uint64_t& { return states.lane(i, j); });
+      }
+
+      states.template permute<num_rounds>();
+    }
+
+    for (size_t j = 0; j < lane_cnt; j++) {
+      if (remaining[j] == 0) {
+        continue;
+      }
+
+      remaining[j] -= lockstep_cnt;
+      if (remaining[j] == 0) {
+        states.squeeze_bytes(j, 0, values[chain_at[j]]);
+      }
+    }
+  }
+}
+
+/**
+ * Same as `advance_chains_using`, but spreads chains across lanes of 8 -way multi-buffer permutation, when the CPU supports AVX-512, otherwise across lanes of
+ * 4 -way multi-buffer permutation.
+ */
+template<uint8_t domain_separator, size_t ds_bit_len, size_t num_bits_in_rate, size_t num_rounds, size_t value_len>
+static inline void
+advance_chains(std::span<std::array<uint8_t, value_len>> values, std::span<const size_t> steps)
+{
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+  if (cpu_features::has_avx512f()) {
+    advance_chains_using<domain_separator, ds_bit_len, num_bits_in_rate, num_rounds, value_len, keccak::X8_STATE_CNT>(values, steps);
+    return;
+  }
+#endif
+
+  advance_chains_using<domain_separator, ds_bit_len, num_bits_in_rate, num_rounds, value_len, keccak::X4_STATE_CNT>(values, steps);
+}
+
+}
@@ -0,0 +1,214 @@
+#pragma once
+#include "sha3/internals/keccak.hpp"
+#include "sha3/internals/keccak_x4.hpp"
+#include "sha3/internals/keccak_x8.hpp"
+#include "sha3/internals/sponge.hpp"
+#include "sha3/internals/sponge_many.hpp"
+#include "sha3/internals/state_batch.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
+
+// Multi-buffer job manager, keeping lanes of multi-buffer Keccak-p[1600] permutation busy, with a stream of messages of unequal length
+namespace sponge {
+
+// Identifier of a job, submitted to `job_manager_t`, which is its submission index, starting from 0.
+using job_id_t = size_t;
+
+/**
+ * Multi-buffer job manager, in the spirit of the one found in Intel's multi-buffer crypto library. Each submitted job is a message and a span of bytes,
+ * where its output is written. Every job occupies one of `lane_cnt` (4 or 8) lanes of `keccak::permute_x4` or `keccak::permute_x8`, from submission until
+ * its output is squeezed, and a lane gets the next job as soon as its current job completes, s.t. lanes are kept busy, no matter how different message
+ * lengths are. Output of each job is bit-identical to absorbing, finalizing and squeezing its message on its own.
+ *
+ * Each step of the manager XORs either the next block of message or, for jobs near their end, the message tail and padding into each busy lane, followed by
+ * a single multi-buffer permutation. Jobs, whose message got padded in the last step, complete by squeezing first `rate/ 8` -bytes of output out of their
+ * lane, while longer outputs are squeezed on the scalar path.
+ *
+ * Both the message and the output span must stay alive until the job completes. A completed job is reported through the callback, if one is set, in order of
+ * completion. Otherwise, completed jobs are returned by `get_completed_job`, in order of submission.
+ */
+template<uint8_t domain_separator, size_t ds_bit_len, size_t num_bits_in_rate, size_t num_rounds, size_t lane_cnt = keccak::X4_STATE_CNT>
+  requires(check_domain_separator(ds_bit_len) && ((lane_cnt == keccak::X4_STATE_CNT) || (lane_cnt == keccak::X8_STATE_CNT)))
+struct job_manager_t
+{
+public:
+  // Callback, invoked with identifier of each completed job.
+  using callback_t = std::function<void(job_id_t)>;
+
+private:
+  static constexpr size_t num_bytes_in_rate = num_bits_in_rate / std::numeric_limits<uint8_t>::digits;
+
+  // Job occupying a lane, along with how many of its message bytes are already absorbed.
+  struct lane_job_t
+  {
+    std::span<const uint8_t> msg{};
+    std::span<uint8_t> out{};
+    size_t msg_offset = 0;
+    job_id_t id = 0;
+    bool busy = false;
+  };
+
+  keccak::state_batch<lane_cnt> states{};
+  std::array<lane_job_t, lane_cnt> lanes{};
+  size_t busy_lane_cnt = 0;
+
+  job_id_t next_job_id = 0;
+  callback_t on_completion{};
+
+  // Completion flags of jobs, starting from `next_job_id_in_order`, only tracked when no callback is set.
+  std::deque<bool> completed{};
+  job_id_t next_job_id_in_order = 0;
+
+  // Squeezes output of the job in lane `j`, whose message is absorbed and padded, followed by a permutation, and reports its completion.
+  void complete(const size_t j)
+  {
+    auto& job = lanes[j];
+
+    const size_t first_chunk_byte_len = std::min(job.out.size(), num_bytes_in_rate);
+    states.squeeze_bytes(j, 0, job.out.first(first_chunk_byte_len));
+
+    if (first_chunk_byte_len < job.out.size()) {
+      std::array<uint64_t, keccak::LANE_CNT> state{};
+      states.load(j, state);
+
+      size_t squeezable = num_bytes_in_rate - first_chunk_byte_len;
+      squeeze<num_bits_in_rate, num_rounds>(state, squeezable, job.out.subspan(first_chunk_byte_len));
+    }
+
+    job.busy = false;
+    busy_lane_cnt--;
+
+    if (on_completion) {
+      on_completion(job.id);
+    } else {
+      completed[job.id - next_job_id_in_order] = true;
+    }
+  }
+
+  // Runs steps of the manager, until at least one of the busy lanes completes its job.
+  void run_until_a_lane_frees()
+  {
+    // Full message blocks, which all busy lanes can absorb, before any of them needs padding, are absorbed first, in a tight loop.
+    size_t common_block_cnt = std::numeric_limits<size_t>::max();
+    for (const auto& job : lanes) {
+      if (job.busy) {
+        common_block_cnt = std::min(common_block_cnt, (job.msg.size() - job.msg_offset) / num_bytes_in_rate);
+      }
+    }
+
+    for (size_t step = 0; step < common_block_cnt; step++) {
+      for (size_t j = 0; j < lane_cnt; j++) {
+        auto& job = lanes[j];
+        if (job.busy) {
+          states.template absorb_block<num_bits_in_rate>(j, job.msg.subspan(job.msg_offset).template first<num_bytes_in_rate>());
+          job.msg_offset += num_bytes_in_rate;
+        }
+      }
+
+      states.template permute<num_rounds>();
+    }
+
+    // Now, at least one busy lane has less than a block of message left, which is absorbed along with padding, while others absorb their next block.
+    std::array<bool, lane_cnt> finishing{};
+    std::array<uint64_t, keccak::LANE_CNT> state{};
+
+    for (size_t j = 0; j < lane_cnt; j++) {
+      auto& job = lanes[j];
+      if (!job.busy) {
+        continue;
+      }
+
+      if ((job.msg.size() - job.msg_offset) >= num_bytes_in_rate) {
+        states.template absorb_block<num_bits_in_rate>(j, job.msg.subspan(job.msg_offset).template first<num_bytes_in_rate>());
+        job.msg_offset += num_bytes_in_rate;
+        continue;
+      }
+
+      states.load(j, state);
+
+      size_t offset = 0;
+      absorb_using<num_bits_in_rate, num_rounds>(state, offset, job.msg.subspan(job.msg_offset));
+      pad<domain_separator, ds_bit_len, num_bits_in_rate>(state, offset);
+
+      states.store(j, state);
+
+      job.msg_offset = job.msg.size();
+      finishing[j] = true;
+    }
+
+    states.template permute<num_rounds>();
+
+    for (size_t j = 0; j < lane_cnt; j++) {
+      if (finishing[j]) {
+        complete(j);
+      }
+    }
+  }
+
+public:
+  job_manager_t() = default;
+
+  // Creates a job manager, which reports each completed job by invoking `callback`, instead of queueing it for `get_completed_job`.
+  explicit job_manager_t(callback_t callback)
+    : on_completion(std::move(callback))
+  {
+  }
+
+  // Returns # -of lanes, which are currently occupied by a job.
+  [[nodiscard]] size_t busy_lanes() const { return busy_lane_cnt; }
+
+  /**
+   * Submits a job, hashing `msg` and writing `out.size()` -bytes of output to `out`, and returns its identifier. The job is put into a free lane and, if
+   * that makes all lanes busy, the manager runs until at least one of them completes its job, s.t. next submission finds a free lane.
+   */
+  job_id_t submit(std::span<const uint8_t> msg, std::span<uint8_t> out)
+  {
+    const job_id_t id = next_job_id++;
+    if (!on_completion) {
+      completed.push_back(false);
+    }
+
+    const auto free_lane = std::ranges::find_if(lanes, [](const auto& job) { return !job.busy; });
+    const auto j = static_cast<size_t>(std::distance(lanes.begin(), free_lane));
+
+    *free_lane = lane_job_t{ .msg = msg, .out = out, .msg_offset = 0, .id = id, .busy = true };
+    states.store(j, {});
+    busy_lane_cnt++;
+
+    if (busy_lane_cnt == lane_cnt) {
+      run_until_a_lane_frees();
+    }
+
+    return id;
+  }
+
+  // Runs the manager until all submitted jobs complete. Lanes, freed up near the end, can't be refilled, so prefer calling it only once no more jobs remain.
+  void flush()
+  {
+    while (busy_lane_cnt > 0) {
+      run_until_a_lane_frees();
+    }
+  }
+
+  // Returns identifier of the earliest submitted job, which is not yet returned, iff it has completed. Jobs are never returned when a callback is set.
+  std::optional<job_id_t> get_completed_job()
+  {
+    if (completed.empty() || !completed.front()) {
+      return std::nullopt;
+    }
+
+    completed.pop_front();
+    return next_job_id_in_order++;
+  }
+};
+
+}
@@ -0,0 +1,241 @@
+#pragma once
+#include "sha3/internals/cpu_features.hpp"
+#include "sha3/internals/keccak.hpp"
+#include "sha3/internals/keccak_x4.hpp"
+#include "sha3/internals/keccak_x8.hpp"
+#include "sha3/internals/sponge.hpp"
+#include "sha3/internals/sponge_many.hpp"
+#include "sha3/internals/state_batch.hpp"
+#include "sha3/internals/thread_pool.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+// KangarooTwelve tree hashing mode, on top of TurboSHAKE, as specified in RFC 9861 https://www.rfc-editor.org/rfc/rfc9861.html
+namespace kangarootwelve {
+
+// Input string S = M || C || length_encode(|C|) is split into chunks of these many bytes, each of them, except the first one, being hashed as a leaf.
+static constexpr size_t CHUNK_BYTE_LEN = 8192;
+
+// Both KT128 and KT256 use TurboSHAKE, which is built on Keccak-p[1600, 12] permutation.
+static constexpr size_t NUM_KECCAK_ROUNDS = 12;
+
+// TurboSHAKE domain separators, for single node ( S fits in a chunk ), leaves ( intermediate nodes ) and final node of the tree.
+static constexpr uint8_t SINGLE_NODE_DOM_SEP = 0x07;
+static constexpr uint8_t LEAF_DOM_SEP = 0x0b;
+static constexpr uint8_t FINAL_NODE_DOM_SEP = 0x06;
+
+// Final node is S_0 || 110^62 || CV_1 || ... || CV_{n-1} || length_encode(n - 1) || FF FF.
+static constexpr std::array<uint8_t, 8> FINAL_NODE_PREFIX{ 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+static constexpr std::array<uint8_t, 2> FINAL_NODE_SUFFIX{ 0xff, 0xff };
+
+// Maximum byte length of `length_encode(x)`, for any x of type size_t.
+static constexpr size_t LENGTH_ENCODE_MAX_BYTE_LEN = sizeof(size_t) + 1;
+
+// # -of leaves hashed by a single task, when leaves are spread across threads, which is 128 KiB of input, a multiple of the widest multi-buffer permutation.
+static constexpr size_t LEAVES_PER_TASK = 16;
+
+/**
+ * Encodes `x` as big-endian byte string, with no leading zero byte, followed by a byte holding length of that string, as defined in section 3.3 of RFC 9861,
+ * writing it to `out`. Returns # -of bytes written, which is 1 for x = 0.
+ */
+static constexpr size_t
+length_encode(const size_t x, std::span<uint8_t, LENGTH_ENCODE_MAX_BYTE_LEN> out)
+{
+  const size_t len = (static_cast<size_t>(std::bit_width(x)) + std::numeric_limits<uint8_t>::digits - 1) / std::numeric_limits<uint8_t>::digits;
+
+  for (size_t i = 0; i < len; i++) {
+    out[i] = static_cast<uint8_t>(x >> ((len - 1 - i) * std::numeric_limits<uint8_t>::digits));
+  }
+  out[len] = static_cast<uint8_t>(len);
+
+  return len + 1;
+}
+
+/**
+ * Hashes `lane_cnt` leaves, laid out one after another in `chunks`, each of `CHUNK_BYTE_LEN` -bytes, together, in lanes of multi-buffer Keccak-p[1600]
+ * permutation, writing their `cv_len` -byte chaining values to `cvs`, in same order. Every leaf has same length, so all of them stay in lockstep, from
+ * first block to squeezing.
+ */
+template<size_t num_bits_in_rate, size_t cv_len, size_t lane_cnt>
+static inline void
+hash_leaf_group(std::span<const uint8_t> chunks, std::span<uint8_t> cvs)
+{
+  constexpr size_t num_bytes_in_rate = num_bits_in_rate / std::numeric_limits<uint8_t>::digits;
+  constexpr size_t full_blocks_byte_len = CHUNK_BYTE_LEN - (CHUNK_BYTE_LEN % num_bytes_in_rate);
+  constexpr size_t tail_byte_len = CHUNK_BYTE_LEN - full_blocks_byte_len;
+
+  keccak::state_batch<lane_cnt> states{};
+
+  for (size_t block_offset = 0; block_offset < full_blocks_byte_len; block_offset += num_bytes_in_rate) {
+    for (size_t j = 0; j < lane_cnt; j++) {
+      states.template absorb_block<num_bits_in_rate>(j, chunks.subspan((j * CHUNK_BYTE_LEN) + block_offset).template first<num_bytes_in_rate>());
+    }
+
+    states.template permute<NUM_KECCAK_ROUNDS>();
+  }
+
+  std::array<uint64_t, keccak::LANE_CNT> state{};
+
+  for (size_t j = 0; j < lane_cnt; j++) {
+    states.absorb_bytes(j, 0, chunks.subspan((j * CHUNK_BYTE_LEN) + full_blocks_byte_len, tail_byte_len));
+
+    states.load(j, state);
+    sponge::pad<LEAF_DOM_SEP, std::bit_width(LEAF_DOM_SEP) - 1, num_bits_in_rate>(state, tail_byte_len);
+    states.store(j, state);
+  }
+
+  states.template permute<NUM_KECCAK_ROUNDS>();
+
+  for (size_t j = 0; j < lane_cnt; j++) {
+    states.squeeze_bytes(j, 0, cvs.subspan(j * cv_len, cv_len));
+  }
+}
+
+/**
+ * Hashes leaves, laid out one after another in `chunks`, each of `CHUNK_BYTE_LEN` -bytes, writing their `cv_len` -byte chaining values to `cvs`, in same
+ * order. Leaves are hashed eight at a time, when the CPU supports AVX-512, then four at a time, and the last few, on the scalar path.
+ */
+template<size_t num_bits_in_rate, size_t cv_len>
+static inline void
+hash_leaves(std::span<const uint8_t> chunks, std::span<uint8_t> cvs)
+{
+  const size_t leaf_cnt = chunks.size() / CHUNK_BYTE_LEN;
+  size_t leaf = 0;
+
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+  if (cpu_features::has_avx512f()) {
+    for (; (leaf_cnt - leaf) >= keccak::X8_STATE_CNT; leaf += keccak::X8_STATE_CNT) {
+      hash_leaf_group<num_bits_in_rate, cv_len, keccak::X8_STATE_CNT>(chunks.subspan(leaf * CHUNK_BYTE_LEN, keccak::X8_STATE_CNT * CHUNK_BYTE_LEN),
+                                                                      cvs.subspan(leaf * cv_len, keccak::X8_STATE_CNT * cv_len));
+    }
+  }
+#endif
+
+  for (; (leaf_cnt - leaf) >= keccak::X4_STATE_CNT; leaf += keccak::X4_STATE_CNT) {
+    hash_leaf_group<num_bits_in_rate, cv_len, keccak::X4_STATE_CNT>(chunks.subspan(leaf * CHUNK_BYTE_LEN, keccak::X4_STATE_CNT * CHUNK_BYTE_LEN),
+                                                                    cvs.subspan(leaf * cv_len, keccak::X4_STATE_CNT * cv_len));
+  }
+
+  for (; leaf < leaf_cnt; leaf++) {
+    sponge::hash_one<LEAF_DOM_SEP, std::bit_width(LEAF_DOM_SEP) - 1, num_bits_in_rate, NUM_KECCAK_ROUNDS>(chunks.subspan(leaf * CHUNK_BYTE_LEN, CHUNK_BYTE_LEN),
+                                                                                                         cvs.subspan(leaf * cv_len, cv_len));
+  }
+}
+
+/**
+ * Same as `hash_leaves`, but when `pool` is given and has more than one thread, leaves get split into tasks of `LEAVES_PER_TASK` leaves, which are spread
+ * across threads of the pool.
+ */
+template<size_t num_bits_in_rate, size_t cv_len>
+static inline void
+hash_leaves(std::span<const uint8_t> chunks, std::span<uint8_t> cvs, sha3_utils::thread_pool_t* const pool)
+{
+  const size_t leaf_cnt = chunks.size() / CHUNK_BYTE_LEN;
+
+  if ((pool == nullptr) || (pool->thread_cnt() == 1) || (leaf_cnt <= LEAVES_PER_TASK)) {
+    hash_leaves<num_bits_in_rate, cv_len>(chunks, cvs);
+    return;
+  }
+
+  const size_t task_cnt = (leaf_cnt + LEAVES_PER_TASK - 1) / LEAVES_PER_TASK;
+
+  pool->parallel_for(task_cnt, [&](const size_t task) {
+    const size_t first_leaf = task * LEAVES_PER_TASK;
+    const size_t task_leaf_cnt = std::min(LEAVES_PER_TASK, leaf_cnt - first_leaf);
+
+    hash_leaves<num_bits_in_rate, cv_len>(chunks.subspan(first_leaf * CHUNK_BYTE_LEN, task_leaf_cnt * CHUNK_BYTE_LEN),
+                                          cvs.subspan(first_leaf * cv_len, task_leaf_cnt * cv_len));
+  });
+}
+
+/**
+ * Absorbs bytes [`begin`, `end`) of S, which is concatenation of `parts`, into `hasher`, without materializing S. Used for chunks, which straddle message,
+ * customization string and its length encoding.
+ */
+template<typename turboshake_t, size_t part_cnt>
+static inline void
+absorb_range(turboshake_t& hasher, const std::array<std::span<const uint8_t>, part_cnt>& parts, const size_t begin, const size_t end)
+{
+  size_t part_begin = 0;
+
+  for (const auto part : parts) {
+    const size_t part_end = part_begin + part.size();
+
+    const size_t lo = std::max(begin, part_begin);
+    const size_t hi = std::min(end, part_end);
+    if (lo < hi) {
+      hasher.absorb(part.subspan(lo - part_begin, hi - lo));
+    }
+
+    part_begin = part_end;
+  }
+}
+
+/**
+ * One-shot KangarooTwelve, writing `out.size()` -bytes of output for message `msg` and customization string `customization`, on top of TurboSHAKE instance
+ * `turboshake_t` ( `turboshake128_t` for KT128 and `turboshake256_t` for KT256 ), with rate of `num_bits_in_rate`, producing `cv_len` -byte chaining values.
+ *
+ * Leaves lying entirely in the message, which are all but the last one or two, are hashed straight out of `msg`, in lanes of multi-buffer permutation, and,
+ * when `pool` is given, across its threads. Leaves touching the customization string are hashed on the scalar path, without copying them.
+ */
+template<typename turboshake_t, size_t num_bits_in_rate, size_t cv_len>
+static inline void
+hash(std::span<const uint8_t> msg, std::span<const uint8_t> customization, std::span<uint8_t> out, sha3_utils::thread_pool_t* const pool)
+{
+  std::array<uint8_t, LENGTH_ENCODE_MAX_BYTE_LEN> encoded_customization_len{};
+  const size_t encoded_customization_len_byte_len = length_encode(customization.size(), encoded_customization_len);
+
+  const auto encoded_customization_len_span = std::span<const uint8_t>(encoded_customization_len).first(encoded_customization_len_byte_len);
+
+  const std::array<std::span<const uint8_t>, 3> parts{ msg, customization, encoded_customization_len_span };
+  const size_t s_len = msg.size() + customization.size() + encoded_customization_len_byte_len;
+
+  turboshake_t final_node;
+
+  if (s_len <= CHUNK_BYTE_LEN) {
+    absorb_range(final_node, parts, 0, s_len);
+    final_node.template finalize<SINGLE_NODE_DOM_SEP>();
+    final_node.squeeze(out);
+
+    return;
+  }
+
+  absorb_range(final_node, parts, 0, CHUNK_BYTE_LEN);
+  final_node.absorb(FINAL_NODE_PREFIX);
+
+  const size_t leaf_cnt = (s_len - 1) / CHUNK_BYTE_LEN;
+  const size_t msg_leaf_cnt = (msg.size() / CHUNK_BYTE_LEN) - std::min<size_t>(msg.size() / CHUNK_BYTE_LEN, 1);
+
+  std::vector<uint8_t> cvs(leaf_cnt * cv_len);
+  auto cvs_span = std::span(cvs);
+
+  if (msg_leaf_cnt > 0) {
+    hash_leaves<num_bits_in_rate, cv_len>(msg.subspan(CHUNK_BYTE_LEN, msg_leaf_cnt * CHUNK_BYTE_LEN), cvs_span.first(msg_leaf_cnt * cv_len), pool);
+  }
+
+  for (size_t leaf = msg_leaf_cnt; leaf < leaf_cnt; leaf++) {
+    const size_t leaf_begin = (leaf + 1) * CHUNK_BYTE_LEN;
+
+    turboshake_t leaf_node;
+    absorb_range(leaf_node, parts, leaf_begin, std::min(leaf_begin + CHUNK_BYTE_LEN, s_len));
+    leaf_node.template finalize<LEAF_DOM_SEP>();
+    leaf_node.squeeze(cvs_span.subspan(leaf * cv_len, cv_len));
+  }
+
+  std::array<uint8_t, LENGTH_ENCODE_MAX_BYTE_LEN> encoded_leaf_cnt{};
+  const size_t encoded_leaf_cnt_byte_len = length_encode(leaf_cnt, encoded_leaf_cnt);
+
+  final_node.absorb(cvs);
+  final_node.absorb(std::span<const uint8_t>(encoded_leaf_cnt).first(encoded_leaf_cnt_byte_len));
+  final_node.absorb(FINAL_NODE_SUFFIX);
+  final_node.template finalize<FINAL_NODE_DOM_SEP>();
+  final_node.squeeze(out);
+}
+
+}
@@ -0,0 +1,262 @@
+#pragma once
+#include "sha3/internals/force_inline.hpp"
+#include "sha3/internals/kangarootwelve.hpp"
+#include "sha3/internals/sponge_many.hpp"
+#include "sha3/internals/thread_pool.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <vector>
+
+// Incremental KangarooTwelve, for messages of unknown length, hashing full leaves on background threads, while rest of the message is still arriving
+namespace kangarootwelve {
+
+// # -of batches of leaves, a streaming hasher keeps in flight, per thread of its pool, bounding its memory use to that many batches of 128 KiB each.
+static constexpr size_t BATCHES_PER_THREAD = 2;
+
+/**
+ * Incremental KangarooTwelve, on top of TurboSHAKE instance `turboshake_t`, with rate of `num_bits_in_rate`, producing `cv_len` -byte chaining values. It
+ * offers usual `absorb() -> finalize() -> squeeze()` cycle, and output is same as one-shot `kangarootwelve::hash`, over whole message.
+ *
+ * First chunk of S is absorbed straight into the final node. Following chunks are buffered in batches of `LEAVES_PER_TASK` leaves, each of which is handed
+ * to a worker of the thread pool, as soon as it is full, to be hashed in lanes of multi-buffer permutation. Batches live in a ring of
+ * `BATCHES_PER_THREAD * thread_cnt` slots. Before a slot gets reused, its batch is waited for and its chaining values are absorbed into the final node, in
+ * order, so that memory use stays bounded, no matter how long the message is. Without a pool, each batch is hashed on the calling thread, when it's full.
+ *
+ * Workers keep pointers into the hasher, so it can neither be copied nor moved, and its destructor waits for batches in flight.
+ */
+template<typename turboshake_t, size_t num_bits_in_rate, size_t cv_len>
+struct stream_t
+{
+public:
+  // Byte length of a batch of leaves, hashed by a single task.
+  static constexpr size_t BATCH_BYTE_LEN = LEAVES_PER_TASK * CHUNK_BYTE_LEN;
+
+private:
+  struct batch_t
+  {
+    std::vector<uint8_t> chunks = std::vector<uint8_t>(BATCH_BYTE_LEN);
+    std::array<uint8_t, LEAVES_PER_TASK * cv_len> cvs{};
+    size_t byte_len = 0;     // # -of bytes of S, buffered in `chunks`
+    bool in_flight = false;  // Handed to a worker, but its chaining values are not yet absorbed into the final node ?
+    bool done = false;       // Chaining values ready ?
+  };
+
+  sha3_utils::thread_pool_t* pool = nullptr;
+  std::vector<batch_t> batches;
+  size_t filling = 0; // Index of the batch, being filled with next bytes of S
+
+  std::mutex mutex;
+  std::condition_variable batch_done;
+
+  turboshake_t final_node;
+  size_t s_len = 0; // # -of bytes of S absorbed so far
+  alignas(4) bool finalized = false;
+
+  // Hashes all complete leaves of batch `idx`, along with the last incomplete one, if any.
+  forceinline void hash_batch(const size_t idx)
+  {
+    auto& batch = batches[idx];
+
+    const size_t full_leaf_cnt = batch.byte_len / CHUNK_BYTE_LEN;
+    const size_t tail_byte_len = batch.byte_len % CHUNK_BYTE_LEN;
+
+    const auto chunks = std::span<const uint8_t>(batch.chunks);
+    const auto cvs = std::span(batch.cvs);
+
+    hash_leaves<num_bits_in_rate, cv_len>(chunks.first(full_leaf_cnt * CHUNK_BYTE_LEN), cvs.first(full_leaf_cnt * cv_len));
+
+    if (tail_byte_len > 0) {
+      sponge::hash_one<LEAF_DOM_SEP, std::bit_width(LEAF_DOM_SEP) - 1, num_bits_in_rate, NUM_KECCAK_ROUNDS>(
+        chunks.subspan(full_leaf_cnt * CHUNK_BYTE_LEN, tail_byte_len), cvs.subspan(full_leaf_cnt * cv_len, cv_len));
+    }
+  }
+
+  // Hands batch `idx` over to a worker of the pool, or hashes it right away, when there's no pool.
+  void dispatch(const size_t idx)
+  {
+    batches[idx].in_flight = true;
+
+    if (pool == nullptr) {
+      hash_batch(idx);
+      batches[idx].done = true;
+      return;
+    }
+
+    pool->submit([this, idx]() {
+      hash_batch(idx);
+
+      {
+        std::scoped_lock lock(mutex);
+        batches[idx].done = true;
+      }
+
+      batch_done.notify_all();
+    });
+  }
+
+  // Waits for batch `idx`, if it is in flight, and absorbs its chaining values into the final node, making the slot reusable.
+  void retire(const size_t idx)
+  {
+    auto& batch = batches[idx];
+    if (!batch.in_flight) {
+      return;
+    }
+
+    {
+      std::unique_lock lock(mutex);
+      batch_done.wait(lock, [&]() { return batch.done; });
+    }
+
+    const size_t leaf_cnt = (batch.byte_len + CHUNK_BYTE_LEN - 1) / CHUNK_BYTE_LEN;
+    final_node.absorb(std::span<const uint8_t>(batch.cvs).first(leaf_cnt * cv_len));
+
+    batch.byte_len = 0;
+    batch.in_flight = false;
+    batch.done = false;
+  }
+
+  // Waits for all batches in flight, from oldest to newest, absorbing their chaining values, in order. Batch being filled is left alone.
+  void retire_all_in_flight()
+  {
+    for (size_t k = 1; k <= batches.size(); k++) {
+      retire((filling + k) % batches.size());
+    }
+  }
+
+  // Absorbs next bytes of S = M || C || length_encode(|C|).
+  void absorb_s(std::span<const uint8_t> bytes)
+  {
+    size_t off = 0;
+
+    if (s_len < CHUNK_BYTE_LEN) {
+      off = std::min(CHUNK_BYTE_LEN - s_len, bytes.size());
+
+      final_node.absorb(bytes.first(off));
+      s_len += off;
+    }
+
+    if ((s_len == CHUNK_BYTE_LEN) && (off < bytes.size())) {
+      // S doesn't fit in a single chunk, so the final node follows S_0 with 110^62.
+      final_node.absorb(FINAL_NODE_PREFIX);
+    }
+
+    while (off < bytes.size()) {
+      auto& batch = batches[filling];
+
+      const size_t copyable_num_bytes = std::min(bytes.size() - off, BATCH_BYTE_LEN - batch.byte_len);
+      std::copy_n(bytes.subspan(off).begin(), copyable_num_bytes, std::span(batch.chunks).subspan(batch.byte_len).begin());
+
+      batch.byte_len += copyable_num_bytes;
+      s_len += copyable_num_bytes;
+      off += copyable_num_bytes;
+
+      if (batch.byte_len == BATCH_BYTE_LEN) {
+        dispatch(filling);
+
+        filling = (filling + 1) % batches.size();
+        retire(filling);
+      }
+    }
+  }
+
+public:
+  // Creates a hasher, which hashes leaves on the calling thread, in lanes of multi-buffer permutation, buffering a single batch of leaves.
+  stream_t()
+    : batches(1)
+  {
+  }
+
+  // Creates a hasher, which hashes leaves on threads of `pool`, keeping at most `BATCHES_PER_THREAD * pool.thread_cnt()` batches of leaves in memory.
+  explicit stream_t(sha3_utils::thread_pool_t& leaf_pool)
+    : pool(leaf_pool.thread_cnt() > 1 ? &leaf_pool : nullptr)
+    , batches(BATCHES_PER_THREAD * leaf_pool.thread_cnt())
+  {
+  }
+
+  stream_t(const stream_t&) = delete;
+  stream_t& operator=(const stream_t&) = delete;
+  stream_t(stream_t&&) = delete;
+  stream_t& operator=(stream_t&&) = delete;
+
+  ~stream_t() { retire_all_in_flight(); }
+
+  /**
+   * Absorbs next `msg.size()` -bytes of message. Can be called any number of times, until `finalize` is called, after which it doesn't do anything. Every full
+   * batch of leaves gets handed to a worker, and this call blocks only when all slots are in flight, until the oldest batch is done.
+   */
+  void absorb(std::span<const uint8_t> msg)
+  {
+    if (!finalized) {
+      absorb_s(msg);
+    }
+  }
+
+  /**
+   * Appends customization string `customization`, which can be empty, to the message, waits for all leaves and finalizes the final node, making it ready for
+   * squeezing. Calling it again doesn't do anything.
+   */
+  void finalize(std::span<const uint8_t> customization = {})
+  {
+    if (finalized) {
+      return;
+    }
+
+    std::array<uint8_t, LENGTH_ENCODE_MAX_BYTE_LEN> encoded_len{};
+    const size_t encoded_customization_len_byte_len = length_encode(customization.size(), encoded_len);
+
+    absorb_s(customization);
+    absorb_s(std::span<const uint8_t>(encoded_len).first(encoded_customization_len_byte_len));
+
+    if (s_len <= CHUNK_BYTE_LEN) {
+      final_node.template finalize<SINGLE_NODE_DOM_SEP>();
+    } else {
+      retire_all_in_flight();
+
+      if (batches[filling].byte_len > 0) {
+        hash_batch(filling);
+        batches[filling].in_flight = true;
+        batches[filling].done = true;
+        retire(filling);
+      }
+
+      const size_t encoded_leaf_cnt_byte_len = length_encode((s_len - 1) / CHUNK_BYTE_LEN, encoded_len);
+
+      final_node.absorb(std::span<const uint8_t>(encoded_len).first(encoded_leaf_cnt_byte_len));
+      final_node.absorb(FINAL_NODE_SUFFIX);
+      final_node.template finalize<FINAL_NODE_DOM_SEP>();
+    }
+
+    finalized = true;
+  }
+
+  // After the hasher is finalized, arbitrary many output bytes can be squeezed by calling this function any number of times.
+  void squeeze(std::span<uint8_t> out)
+  {
+    if (finalized) {
+      final_node.squeeze(out);
+    }
+  }
+
+  // Resets the hasher, waiting for batches in flight, s.t. it can be used for another `absorb() -> finalize() -> squeeze()` cycle.
+  void reset()
+  {
+    retire_all_in_flight();
+
+    for (auto& batch : batches) {
+      batch.byte_len = 0;
+    }
+
+    filling = 0;
+    final_node.reset();
+    s_len = 0;
+    finalized = false;
+  }
+};
+
+}
@@ -1,127 +1,146 @@
 #pragma once
+#include "sha3/internals/backend.hpp"
+#include "sha3/internals/cpu_features.hpp"
 #include "sha3/internals/force_inline.hpp"
+#include "sha3/internals/keccak_avx2.hpp"
+#include "sha3/internals/keccak_avx512.hpp"
+#include "sha3/internals/keccak_bit_interleaved.hpp"
+#include "sha3/internals/keccak_constants.hpp"
+#include "sha3/internals/keccak_lane_complementing.hpp"
+#include "sha3/internals/keccak_neon_sha3.hpp"
 #include <array>
 #include <bit>
 #include <cstddef>
 #include <cstdint>
-#include <limits>
 #include <span>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Number of rounds, unrolled in the body of the round loop, of the portable scalar implementation of Keccak-p[1600] permutation - either 1, 2, 4 or 24.
+ * As the permutation gets inlined into every absorb, finalize and squeeze routine, smaller depth trades some speed for less I-cache footprint. Default is
+ * 4, see `roundx4`. Define `SHA3_KECCAK_UNROLL` (or pass `-DSHA3_KECCAK_UNROLL=...` to CMake) for overriding it.
+ */
+#if !defined(SHA3_KECCAK_UNROLL)
+#define SHA3_KECCAK_UNROLL 4
+#endif
 
 // Keccak-p[1600, 12] and Keccak-p[1600, 24] (aka Keccak-f[1600]) permutation
 namespace keccak {
 
-// Logarithmic base 2 of bit width of lane i.e. log2(LANE_BW)
-static constexpr size_t L = 6;
-
-// Bit width of each lane of Keccak-f[1600] state
-static constexpr size_t LANE_BW = 1UL << L;
-
-// Bit length of Keccak-f[1600] permutation state
-static constexpr size_t STATE_BIT_LEN = 1600;
-
-// Byte length of Keccak-f[1600] permutation state
-static constexpr size_t STATE_BYTE_LEN = STATE_BIT_LEN / std::numeric_limits<uint8_t>::digits;
+// Unroll depth of the round loop, of the portable scalar implementation of Keccak-p[1600] permutation, see `SHA3_KECCAK_UNROLL`.
+static constexpr size_t UNROLL_DEPTH = SHA3_KECCAK_UNROLL;
 
-// # -of lanes (each of 64 -bit width) in Keccak-f[1600] state
-static constexpr size_t LANE_CNT = STATE_BIT_LEN / LANE_BW;
+// Returns true iff the round loop of the portable scalar implementation of Keccak-p[1600] permutation can be unrolled `unroll` -times.
+consteval bool
+is_valid_unroll_depth(const size_t unroll)
+{
+  return (unroll == 1) || (unroll == 2) || (unroll == 4) || (unroll == MAX_NUM_ROUNDS);
+}
 
-// Maximum number of rounds Keccak-p[b, nr] permutation can be applied s.t. b = 1600, w = b/ 25, l = log2(w), nr = 12 + 2l.
-static constexpr size_t MAX_NUM_ROUNDS = 12 + (2 * L);
+static_assert(is_valid_unroll_depth(UNROLL_DEPTH), "SHA3_KECCAK_UNROLL must be one of 1, 2, 4 or 24.");
 
 /**
- * Leftwards circular rotation offset of 25 lanes ( each lane is 64 -bit wide ) of state array, as provided in table 2
- * below algorithm 2 in section 3.2.2 of https://dx.doi.org/10.6028/NIST.FIPS.202.
- *
- * Note, following offsets are obtained by performing % 64 (bit width of lane) on offsets provided in above mentioned link.
- */
-static constexpr std::array<int, LANE_CNT> ROT{ 0 % LANE_BW,   1 % LANE_BW,   190 % LANE_BW, 28 % LANE_BW, 91 % LANE_BW, 36 % LANE_BW,  300 % LANE_BW,
-                                                6 % LANE_BW,   55 % LANE_BW,  276 % LANE_BW, 3 % LANE_BW,  10 % LANE_BW, 171 % LANE_BW, 153 % LANE_BW,
-                                                231 % LANE_BW, 105 % LANE_BW, 45 % LANE_BW,  15 % LANE_BW, 21 % LANE_BW, 136 % LANE_BW, 210 % LANE_BW,
-                                                66 % LANE_BW,  253 % LANE_BW, 120 % LANE_BW, 78 % LANE_BW };
-
-/**
- * Precomputed table used for looking up source index during application of `π` step mapping function on Keccak-f[1600] state.
- * print('to <= from')
- * for y in range(5):
- *    for x in range(5):
- *        print(f'{y * 5 + x} <= {x * 5 + (x + 3 * y) % 5}')
- *
- * Table generated using above Python code snippet. See section 3.2.3 of the specification https://dx.doi.org/10.6028/NIST.FIPS.202.
+ * Whether the scalar backend of Keccak-p[1600] permutation uses the bit-interleaved implementation, see keccak_bit_interleaved.hpp, which only needs 32 -bit
+ * operations. It is the default on 32 -bit targets i.e. when `sizeof(void*) == 4`, where each 64 -bit rotation would otherwise cost several shifts and ORs.
+ * Define `SHA3_KECCAK_BIT_INTERLEAVED` as 0 or 1 (or pass `-DSHA3_KECCAK_BIT_INTERLEAVED=...` to CMake) for overriding it.
  */
-static constexpr std::array<size_t, LANE_CNT> PERM{ 0, 6, 12, 18, 24, 3, 9, 10, 16, 22, 1, 7, 13, 19, 20, 4, 5, 11, 17, 23, 2, 8, 14, 15, 21 };
+#if defined(SHA3_KECCAK_BIT_INTERLEAVED)
+static constexpr bool BIT_INTERLEAVED = SHA3_KECCAK_BIT_INTERLEAVED != 0;
+#else
+static constexpr bool BIT_INTERLEAVED = sizeof(void*) == 4;
+#endif
 
-/**
- * Computes single bit of Keccak-f[1600] round constant (at compile-time), using binary LFSR, defined by primitive polynomial `x^8 + x^6 + x^5 + x^4 + 1`.
- *
- * See algorithm 5 in section 3.2.5 of http://dx.doi.org/10.6028/NIST.FIPS.202.
- *
- * Taken from https://github.com/itzmeanjan/elephant/blob/2a21c7e/include/keccak.hpp#L24-L59.
- */
-static consteval bool
-rc(const size_t t)
+// Variants of χ step mapping function, computing `a ^ (~b & c)` for each lane, of the portable scalar implementation of Keccak-p[1600] permutation.
+enum class chi_t : uint8_t
+{
+  standard,           // NOT followed by AND, which compilers fuse into `andn`, only when BMI1 is enabled.
+  andn,               // Explicit BMI1 `andn`, on CPUs supporting it, otherwise same as the standard variant.
+  lane_complementing, // Six lanes are kept complemented, s.t. most NOTs are replaced by AND or OR, see keccak_lane_complementing.hpp.
+};
+
+// Computes `~x & y`. The `andn` variant emits BMI1 `andn` instruction, which must only be executed on CPUs supporting it.
+template<chi_t chi>
+static forceinline constexpr uint64_t
+andnot(const uint64_t x, const uint64_t y)
 {
-  // Step 1 of algorithm 5
-  if (t % 255 == 0) {
-    return true;
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+  if constexpr (chi == chi_t::andn) {
+    if (!std::is_constant_evaluated()) {
+      // Inline assembly, instead of `_andn_u64`, so that it gets inlined into callers which are not compiled with BMI1 enabled.
+      uint64_t res = 0;
+      asm("andnq %2, %1, %0" : "=r"(res) : "r"(x), "rm"(y) : "cc");
+      return res;
+    }
   }
+#endif
 
-  // Step 2 of algorithm 5
-  //
-  // Note, step 3.a of algorithm 5 is also being executed in this statement ( for first iteration, with i = 1 ) !
-  uint16_t r = 0b10000000;
-
-  // Step 3 of algorithm 5
-  for (size_t i = 1; i <= t % 255; i++) {
-    const uint16_t b0 = r & 1;
-
-    r = static_cast<uint16_t>((r & 0b011111111) ^ ((((r >> 8) & 1) ^ b0) << 8));
-    r = static_cast<uint16_t>((r & 0b111101111) ^ ((((r >> 4) & 1) ^ b0) << 4));
-    r = static_cast<uint16_t>((r & 0b111110111) ^ ((((r >> 3) & 1) ^ b0) << 3));
-    r = static_cast<uint16_t>((r & 0b111111011) ^ ((((r >> 2) & 1) ^ b0) << 2));
-
-    // Step 3.f of algorithm 5
-    //
-    // Note, this statement also executes step 3.a for upcoming iterations ( i.e. when i > 1 )
-    r >>= 1;
-  }
+  return ~x & y;
+}
 
-  return static_cast<bool>((r >> 7) & 1);
+// Fused θ (continued), ρ and π step mapping functions, s.t. lane `i` of `b` is lane `PERM[i]` of `state`, after θ and ρ. Rotation offsets are
+// compile-time constants.
+template<size_t... i>
+static forceinline constexpr void
+rho_pi(std::array<uint64_t, LANE_CNT>& b,
+       const std::array<uint64_t, LANE_CNT>& state,
+       const std::array<uint64_t, 5>& d,
+       std::index_sequence<i...> /* unused */)
+{
+  ((b[i] = std::rotl(state[PERM[i]] ^ d[PERM[i] % 5], ROT[PERM[i]])), ...);
 }
 
 /**
- * Computes 64 -bit round constant (at compile-time), which is XOR-ed into the very first lane ( = lane(0, 0) ) of Keccak-f[1600] permutation state.
+ * Keccak-f[1600] round function, applying all five step mapping functions, updating state array. Unlike `roundx4`, it applies a single round `ridx`,
+ * keeping code size of the round loop small. χ step mapping function is computed as requested by template argument, see `chi_t`.
  *
- * Taken from https://github.com/itzmeanjan/elephant/blob/2a21c7e/include/keccak.hpp#L61-L74.
+ * See section 3.3 of https://dx.doi.org/10.6028/NIST.FIPS.202.
  */
-static consteval uint64_t
-compute_rc(const size_t r_idx)
+template<chi_t chi = chi_t::standard>
+static forceinline constexpr void
+round(std::array<uint64_t, LANE_CNT>& state, const size_t ridx)
 {
-  uint64_t tmp = 0;
+  std::array<uint64_t, 5> c{};
+  std::array<uint64_t, 5> d{};
+  std::array<uint64_t, LANE_CNT> b{};
 
-  for (size_t j = 0; j < (L + 1); j++) {
-    const size_t boff = (1 << j) - 1;
-    tmp |= static_cast<uint64_t>(rc(j + (7 * r_idx))) << boff;
+  // θ step mapping
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 5
+#endif
+  for (size_t x = 0; x < c.size(); x++) {
+    c[x] = state[x] ^ state[x + 5] ^ state[x + 10] ^ state[x + 15] ^ state[x + 20];
   }
 
-  return tmp;
-}
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 5
+#endif
+  for (size_t x = 0; x < d.size(); x++) {
+    d[x] = c[(x + 4) % 5] ^ std::rotl(c[(x + 1) % 5], 1);
+  }
 
-// Compile-time evaluate Keccak-f[1600] round constants.
-static consteval std::array<uint64_t, MAX_NUM_ROUNDS>
-compute_rcs()
-{
-  std::array<uint64_t, MAX_NUM_ROUNDS> res{};
+  // ρ and π step mapping
+  rho_pi(b, state, d, std::make_index_sequence<LANE_CNT>{});
 
-  for (size_t i = 0; i < MAX_NUM_ROUNDS; i++) {
-    res[i] = compute_rc(i);
+  // χ step mapping
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 25
+#endif
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    const size_t row = i - (i % 5);
+    state[i] = b[i] ^ andnot<chi>(b[row + ((i + 1) % 5)], b[row + ((i + 2) % 5)]);
   }
 
-  return res;
+  // ι step mapping
+  state[0] ^= RC[ridx];
 }
 
-// Round constants to be XORed with lane (0, 0) of Keccak-f[1600] permutation state. See section 3.2.5 of https://dx.doi.org/10.s6028/NIST.FIPS.202.
-static constexpr std::array<uint64_t, MAX_NUM_ROUNDS> RC = compute_rcs();
-
 /**
  * Keccak-f[1600] round function, applying all five step mapping functions, updating state array.
  * Note this implementation of round function applies four consecutive rounds in a single call i.e. if you invoke it to apply round `i`
@@ -131,9 +150,12 @@ static constexpr std::array<uint64_t, MAX_NUM_ROUNDS> RC = compute_rcs();
  * - And then round `i+2`
  * - And finally round `i+3`
  *
+ * χ step mapping function is computed as requested by template argument, see `chi_t`.
+ *
  * See section 3.3 of https://dx.doi.org/10.6028/NIST.FIPS.202.
  * This implementation collects a lot of inspiration from https://github.com/bwesterb/armed-keccak.git.
  */
+template<chi_t chi = chi_t::standard>
 static forceinline constexpr void
 roundx4(std::span<uint64_t, LANE_CNT> state, const size_t ridx)
 {
@@ -178,11 +200,11 @@ roundx4(std::span<uint64_t, LANE_CNT> state, const size_t ridx)
   t = state[24] ^ d[4];
   bc[4] = std::rotl(t, ROT[24]);
 
-  state[0] = bc[0] ^ (bc[2] & ~bc[1]) ^ RC[ridx];
-  state[6] = bc[1] ^ (bc[3] & ~bc[2]);
-  state[12] = bc[2] ^ (bc[4] & ~bc[3]);
-  state[18] = bc[3] ^ (bc[0] & ~bc[4]);
-  state[24] = bc[4] ^ (bc[1] & ~bc[0]);
+  state[0] = bc[0] ^ andnot<chi>(bc[1], bc[2]) ^ RC[ridx];
+  state[6] = bc[1] ^ andnot<chi>(bc[2], bc[3]);
+  state[12] = bc[2] ^ andnot<chi>(bc[3], bc[4]);
+  state[18] = bc[3] ^ andnot<chi>(bc[4], bc[0]);
+  state[24] = bc[4] ^ andnot<chi>(bc[0], bc[1]);
 
   t = state[10] ^ d[0];
   bc[2] = std::rotl(t, ROT[10]);
@@ -195,11 +217,11 @@ roundx4(std::span<uint64_t, LANE_CNT> state, const size_t ridx)
   t = state[9] ^ d[4];
   bc[1] = std::rotl(t, ROT[9]);
 
-  state[10] = bc[0] ^ (bc[2] & ~bc[1]);
-  state[16] = bc[1] ^ (bc[3] & ~bc[2]);
-  state[22] = bc[2] ^ (bc[4] & ~bc[3]);
-  state[3] = bc[3] ^ (bc[0] & ~bc[4]);
-  state[9] = bc[4] ^ (bc[1] & ~bc[0]);
+  state[10] = bc[0] ^ andnot<chi>(bc[1], bc[2]);
+  state[16] = bc[1] ^ andnot<chi>(bc[2], bc[3]);
+  state[22] = bc[2] ^ andnot<chi>(bc[3], bc[4]);
+  state[3] = bc[3] ^ andnot<chi>(bc[4], bc[0]);
+  state[9] = bc[4] ^ andnot<chi>(bc[0], bc[1]);
 
   t = state[20] ^ d[0];
   bc[4] = std::rotl(t, ROT[20]);
@@ -212,11 +234,11 @@ roundx4(std::span<uint64_t, LANE_CNT> state, const size_t ridx)
   t = state[19] ^ d[4];
   bc[3] = std::rotl(t, ROT[19]);
 
-  state[20] = bc[0] ^ (bc[2] & ~bc[1]);
-  state[1] = bc[1] ^ (bc[3] & ~bc[2]);
-  state[7] = bc[2] ^ (bc[4] & ~bc[3]);
-  state[13] = bc[3] ^ (bc[0] & ~bc[4]);
-  state[19] = bc[4] ^ (bc[1] & ~bc[0]);
+  state[20] = bc[0] ^ andnot<chi>(bc[1], bc[2]);
+  state[1] = bc[1] ^ andnot<chi>(bc[2], bc[3]);
+  state[7] = bc[2] ^ andnot<chi>(bc[3], bc[4]);
+  state[13] = bc[3] ^ andnot<chi>(bc[4], bc[0]);
+  state[19] = bc[4] ^ andnot<chi>(bc[0], bc[1]);
 
   t = state[5] ^ d[0];
   bc[1] = std::rotl(t, ROT[5]);
@@ -229,11 +251,11 @@ roundx4(std::span<uint64_t, LANE_CNT> state, const size_t ridx)
   t = state[4] ^ d[4];
   bc[0] = std::rotl(t, ROT[4]);
 
-  state[5] = bc[0] ^ (bc[2] & ~bc[1]);
-  state[11] = bc[1] ^ (bc[3] & ~bc[2]);
-  state[17] = bc[2] ^ (bc[4] & ~bc[3]);
-  state[23] = bc[3] ^ (bc[0] & ~bc[4]);
-  state[4] = bc[4] ^ (bc[1] & ~bc[0]);
+  state[5] = bc[0] ^ andnot<chi>(bc[1], bc[2]);
+  state[11] = bc[1] ^ andnot<chi>(bc[2], bc[3]);
+  state[17] = bc[2] ^ andnot<chi>(bc[3], bc[4]);
+  state[23] = bc[3] ^ andnot<chi>(bc[4], bc[0]);
+  state[4] = bc[4] ^ andnot<chi>(bc[0], bc[1]);
 
   t = state[15] ^ d[0];
   bc[3] = std::rotl(t, ROT[15]);
@@ -246,11 +268,11 @@ roundx4(std::span<uint64_t, LANE_CNT> state, const size_t ridx)
   t = state[14] ^ d[4];
   bc[2] = std::rotl(t, ROT[14]);
 
-  state[15] = bc[0] ^ (bc[2] & ~bc[1]);
-  state[21] = bc[1] ^ (bc[3] & ~bc[2]);
-  state[2] = bc[2] ^ (bc[4] & ~bc[3]);
-  state[8] = bc[3] ^ (bc[0] & ~bc[4]);
-  state[14] = bc[4] ^ (bc[1] & ~bc[0]);
+  state[15] = bc[0] ^ andnot<chi>(bc[1], bc[2]);
+  state[21] = bc[1] ^ andnot<chi>(bc[2], bc[3]);
+  state[2] = bc[2] ^ andnot<chi>(bc[3], bc[4]);
+  state[8] = bc[3] ^ andnot<chi>(bc[4], bc[0]);
+  state[14] = bc[4] ^ andnot<chi>(bc[0], bc[1]);
 
   // Round ridx + 1
   std::fill(bc.begin(), bc.end(), 0x00);
@@ -287,11 +309,11 @@ roundx4(std::span<uint64_t, LANE_CNT> state, const size_t ridx)
   t = state[14] ^ d[4];
   bc[4] = std::rotl(t, ROT[24]);
 
-  state[0] = bc[0] ^ (bc[2] & ~bc[1]) ^ RC[ridx + 1];
-  state[16] = bc[1] ^ (bc[3] & ~bc[2]);
-  state[7] = bc[2] ^ (bc[4] & ~bc[3]);
-  state[23] = bc[3] ^ (bc[0] & ~bc[4]);
-  state[14] = bc[4] ^ (bc[1] & ~bc[0]);
+  state[0] = bc[0] ^ andnot<chi>(bc[1], bc[2]) ^ RC[ridx + 1];
+  state[16] = bc[1] ^ andnot<chi>(bc[2], bc[3]);
+  state[7] = bc[2] ^ andnot<chi>(bc[3], bc[4]);
+  state[23] = bc[3] ^ andnot<chi>(bc[4], bc[0]);
+  state[14] = bc[4] ^ andnot<chi>(bc[0], bc[1]);
 
   t = state[20] ^ d[0];
   bc[2] = std::rotl(t, ROT[10]);
@@ -304,11 +326,11 @@ roundx4(std::span<uint64_t, LANE_CNT> state, const size_t ridx)
   t = state[9] ^ d[4];
   bc[1] = std::rotl(t, ROT[9]);
 
-  state[20] = bc[0] ^ (bc[2] & ~bc[1]);
-  state[11] = bc[1] ^ (bc[3] & ~bc[2]);
-  state[2] = bc[2] ^ (bc[4] & ~bc[3]);
-  state[18] = bc[3] ^ (bc[0] & ~bc[4]);
-  state[9] = bc[4] ^ (bc[1] & ~bc[0]);
+  state[20] = bc[0] ^ andnot<chi>(bc[1], bc[2]);
+  state[11] = bc[1] ^ andnot<chi>(bc[2], bc[3]);
+  state[2] = bc[2] ^ andnot<chi>(bc[3], bc[4]);
+  state[18] = bc[3] ^ andnot<chi>(bc[4], bc[0]);
+  state[9] = bc[4] ^ andnot<chi>(bc[0], bc[1]);
 
   t = state[15] ^ d[0];
   bc[4] = std::rotl(t, ROT[20]);
@@ -321,11 +343,11 @@ roundx4(std::span<uint64_t, LANE_CNT> state, const size_t ridx)
   t = state[4] ^ d[4];
   bc[3] = std::rotl(t, ROT[19]);
 
-  state[15] = bc[0] ^ (bc[2] & ~bc[1]);
-  state[6] = bc[1] ^ (bc[3] & ~bc[2]);
-  state[22] = bc[2] ^ (bc[4] & ~bc[3]);
-  state[13] = bc[3] ^ (bc[0] & ~bc[4]);
-  state[4] = bc[4] ^ (bc[1] & ~bc[0]);
+  state[15] = bc[0] ^ andnot<chi>(bc[1], bc[2]);
+  state[6] = bc[1] ^ andnot<chi>(bc[2], bc[3]);
+  state[22] = bc[2] ^ andnot<chi>(bc[3], bc[4]);
+  state[13] = bc[3] ^ andnot<chi>(bc[4], bc[0]);
+  state[4] = bc[4] ^ andnot<chi>(bc[0], bc[1]);
 
   t = state[10] ^ d[0];
   bc[1] = std::rotl(t, ROT[5]);
@@ -338,11 +360,11 @@ roundx4(std::span<uint64_t, LANE_CNT> state, const size_t ridx)
   t = state[24] ^ d[4];
   bc[0] = std::rotl(t, ROT[4]);
 
-  state[10] = bc[0] ^ (bc[2] & ~bc[1]);
-  state[1] = bc[1] ^ (bc[3] & ~bc[2]);
-  state[17] = bc[2] ^ (bc[4] & ~bc[3]);
-  state[8] = bc[3] ^ (bc[0] & ~bc[4]);
-  state[24] = bc[4] ^ (bc[1] & ~bc[0]);
+  state[10] = bc[0] ^ andnot<chi>(bc[1], bc[2]);
+  state[1] = bc[1] ^ andnot<chi>(bc[2], bc[3]);
+  state[17] = bc[2] ^ andnot<chi>(bc[3], bc[4]);
+  state[8] = bc[3] ^ andnot<chi>(bc[4], bc[0]);
+  state[24] = bc[4] ^ andnot<chi>(bc[0], bc[1]);
 
   t = state[5] ^ d[0];
   bc[3] = std::rotl(t, ROT[15]);
@@ -355,11 +377,11 @@ roundx4(std::span<uint64_t, LANE_CNT> state, const size_t ridx)
   t = state[19] ^ d[4];
   bc[2] = std::rotl(t, ROT[14]);
 
-  state[5] = bc[0] ^ (bc[2] & ~bc[1]);
-  state[21] = bc[1] ^ (bc[3] & ~bc[2]);
-  state[12] = bc[2] ^ (bc[4] & ~bc[3]);
-  state[3] = bc[3] ^ (bc[0] & ~bc[4]);
-  state[19] = bc[4] ^ (bc[1] & ~bc[0]);
+  state[5] = bc[0] ^ andnot<chi>(bc[1], bc[2]);
+  state[21] = bc[1] ^ andnot<chi>(bc[2], bc[3]);
+  state[12] = bc[2] ^ andnot<chi>(bc[3], bc[4]);
+  state[3] = bc[3] ^ andnot<chi>(bc[4], bc[0]);
+  state[19] = bc[4] ^ andnot<chi>(bc[0], bc[1]);
 
   // Round ridx + 2
   std::fill(bc.begin(), bc.end(), 0x00);
@@ -396,11 +418,11 @@ roundx4(std::span<uint64_t, LANE_CNT> state, const size_t ridx)
   t = state[19] ^ d[4];
   bc[4] = std::rotl(t, ROT[24]);
 
-  state[0] = bc[0] ^ (bc[2] & ~bc[1]) ^ RC[ridx + 2];
-  state[11] = bc[1] ^ (bc[3] & ~bc[2]);
-  state[22] = bc[2] ^ (bc[4] & ~bc[3]);
-  state[8] = bc[3] ^ (bc[0] & ~bc[4]);
-  state[19] = bc[4] ^ (bc[1] & ~bc[0]);
+  state[0] = bc[0] ^ andnot<chi>(bc[1], bc[2]) ^ RC[ridx + 2];
+  state[11] = bc[1] ^ andnot<chi>(bc[2], bc[3]);
+  state[22] = bc[2] ^ andnot<chi>(bc[3], bc[4]);
+  state[8] = bc[3] ^ andnot<chi>(bc[4], bc[0]);
+  state[19] = bc[4] ^ andnot<chi>(bc[0], bc[1]);
 
   t = state[15] ^ d[0];
   bc[2] = std::rotl(t, ROT[10]);
@@ -413,11 +435,11 @@ roundx4(std::span<uint64_t, LANE_CNT> state, const size_t ridx)
   t = state[9] ^ d[4];
   bc[1] = std::rotl(t, ROT[9]);
 
-  state[15] = bc[0] ^ (bc[2] & ~bc[1]);
-  state[1] = bc[1] ^ (bc[3] & ~bc[2]);
-  state[12] = bc[2] ^ (bc[4] & ~bc[3]);
-  state[23] = bc[3] ^ (bc[0] & ~bc[4]);
-  state[9] = bc[4] ^ (bc[1] & ~bc[0]);
+  state[15] = bc[0] ^ andnot<chi>(bc[1], bc[2]);
+  state[1] = bc[1] ^ andnot<chi>(bc[2], bc[3]);
+  state[12] = bc[2] ^ andnot<chi>(bc[3], bc[4]);
+  state[23] = bc[3] ^ andnot<chi>(bc[4], bc[0]);
+  state[9] = bc[4] ^ andnot<chi>(bc[0], bc[1]);
 
   t = state[5] ^ d[0];
   bc[4] = std::rotl(t, ROT[20]);
@@ -430,11 +452,11 @@ roundx4(std::span<uint64_t, LANE_CNT> state, const size_t ridx)
   t = state[24] ^ d[4];
   bc[3] = std::rotl(t, ROT[19]);
 
-  state[5] = bc[0] ^ (bc[2] & ~bc[1]);
-  state[16] = bc[1] ^ (bc[3] & ~bc[2]);
-  state[2] = bc[2] ^ (bc[4] & ~bc[3]);
-  state[13] = bc[3] ^ (bc[0] & ~bc[4]);
-  state[24] = bc[4] ^ (bc[1] & ~bc[0]);
+  state[5] = bc[0] ^ andnot<chi>(bc[1], bc[2]);
+  state[16] = bc[1] ^ andnot<chi>(bc[2], bc[3]);
+  state[2] = bc[2] ^ andnot<chi>(bc[3], bc[4]);
+  state[13] = bc[3] ^ andnot<chi>(bc[4], bc[0]);
+  state[24] = bc[4] ^ andnot<chi>(bc[0], bc[1]);
 
   t = state[20] ^ d[0];
   bc[1] = std::rotl(t, ROT[5]);
@@ -447,11 +469,11 @@ roundx4(std::span<uint64_t, LANE_CNT> state, const size_t ridx)
   t = state[14] ^ d[4];
   bc[0] = std::rotl(t, ROT[4]);
 
-  state[20] = bc[0] ^ (bc[2] & ~bc[1]);
-  state[6] = bc[1] ^ (bc[3] & ~bc[2]);
-  state[17] = bc[2] ^ (bc[4] & ~bc[3]);
-  state[3] = bc[3] ^ (bc[0] & ~bc[4]);
-  state[14] = bc[4] ^ (bc[1] & ~bc[0]);
+  state[20] = bc[0] ^ andnot<chi>(bc[1], bc[2]);
+  state[6] = bc[1] ^ andnot<chi>(bc[2], bc[3]);
+  state[17] = bc[2] ^ andnot<chi>(bc[3], bc[4]);
+  state[3] = bc[3] ^ andnot<chi>(bc[4], bc[0]);
+  state[14] = bc[4] ^ andnot<chi>(bc[0], bc[1]);
 
   t = state[10] ^ d[0];
   bc[3] = std::rotl(t, ROT[15]);
@@ -464,11 +486,11 @@ roundx4(std::span<uint64_t, LANE_CNT> state, const size_t ridx)
   t = state[4] ^ d[4];
   bc[2] = std::rotl(t, ROT[14]);
 
-  state[10] = bc[0] ^ (bc[2] & ~bc[1]);
-  state[21] = bc[1] ^ (bc[3] & ~bc[2]);
-  state[7] = bc[2] ^ (bc[4] & ~bc[3]);
-  state[18] = bc[3] ^ (bc[0] & ~bc[4]);
-  state[4] = bc[4] ^ (bc[1] & ~bc[0]);
+  state[10] = bc[0] ^ andnot<chi>(bc[1], bc[2]);
+  state[21] = bc[1] ^ andnot<chi>(bc[2], bc[3]);
+  state[7] = bc[2] ^ andnot<chi>(bc[3], bc[4]);
+  state[18] = bc[3] ^ andnot<chi>(bc[4], bc[0]);
+  state[4] = bc[4] ^ andnot<chi>(bc[0], bc[1]);
 
   // Round ridx + 3
   std::fill(bc.begin(), bc.end(), 0x00);
@@ -505,11 +527,11 @@ roundx4(std::span<uint64_t, LANE_CNT> state, const size_t ridx)
   t = state[4] ^ d[4];
   bc[4] = std::rotl(t, ROT[24]);
 
-  state[0] = bc[0] ^ (bc[2] & ~bc[1]) ^ RC[ridx + 3];
-  state[1] = bc[1] ^ (bc[3] & ~bc[2]);
-  state[2] = bc[2] ^ (bc[4] & ~bc[3]);
-  state[3] = bc[3] ^ (bc[0] & ~bc[4]);
-  state[4] = bc[4] ^ (bc[1] & ~bc[0]);
+  state[0] = bc[0] ^ andnot<chi>(bc[1], bc[2]) ^ RC[ridx + 3];
+  state[1] = bc[1] ^ andnot<chi>(bc[2], bc[3]);
+  state[2] = bc[2] ^ andnot<chi>(bc[3], bc[4]);
+  state[3] = bc[3] ^ andnot<chi>(bc[4], bc[0]);
+  state[4] = bc[4] ^ andnot<chi>(bc[0], bc[1]);
 
   t = state[5] ^ d[0];
   bc[2] = std::rotl(t, ROT[10]);
@@ -522,11 +544,11 @@ roundx4(std::span<uint64_t, LANE_CNT> state, const size_t ridx)
   t = state[9] ^ d[4];
   bc[1] = std::rotl(t, ROT[9]);
 
-  state[5] = bc[0] ^ (bc[2] & ~bc[1]);
-  state[6] = bc[1] ^ (bc[3] & ~bc[2]);
-  state[7] = bc[2] ^ (bc[4] & ~bc[3]);
-  state[8] = bc[3] ^ (bc[0] & ~bc[4]);
-  state[9] = bc[4] ^ (bc[1] & ~bc[0]);
+  state[5] = bc[0] ^ andnot<chi>(bc[1], bc[2]);
+  state[6] = bc[1] ^ andnot<chi>(bc[2], bc[3]);
+  state[7] = bc[2] ^ andnot<chi>(bc[3], bc[4]);
+  state[8] = bc[3] ^ andnot<chi>(bc[4], bc[0]);
+  state[9] = bc[4] ^ andnot<chi>(bc[0], bc[1]);
 
   t = state[10] ^ d[0];
   bc[4] = std::rotl(t, ROT[20]);
@@ -539,11 +561,11 @@ roundx4(std::span<uint64_t, LANE_CNT> state, const size_t ridx)
   t = state[14] ^ d[4];
   bc[3] = std::rotl(t, ROT[19]);
 
-  state[10] = bc[0] ^ (bc[2] & ~bc[1]);
-  state[11] = bc[1] ^ (bc[3] & ~bc[2]);
-  state[12] = bc[2] ^ (bc[4] & ~bc[3]);
-  state[13] = bc[3] ^ (bc[0] & ~bc[4]);
-  state[14] = bc[4] ^ (bc[1] & ~bc[0]);
+  state[10] = bc[0] ^ andnot<chi>(bc[1], bc[2]);
+  state[11] = bc[1] ^ andnot<chi>(bc[2], bc[3]);
+  state[12] = bc[2] ^ andnot<chi>(bc[3], bc[4]);
+  state[13] = bc[3] ^ andnot<chi>(bc[4], bc[0]);
+  state[14] = bc[4] ^ andnot<chi>(bc[0], bc[1]);
 
   t = state[15] ^ d[0];
   bc[1] = std::rotl(t, ROT[5]);
@@ -556,11 +578,11 @@ roundx4(std::span<uint64_t, LANE_CNT> state, const size_t ridx)
   t = state[19] ^ d[4];
   bc[0] = std::rotl(t, ROT[4]);
 
-  state[15] = bc[0] ^ (bc[2] & ~bc[1]);
-  state[16] = bc[1] ^ (bc[3] & ~bc[2]);
-  state[17] = bc[2] ^ (bc[4] & ~bc[3]);
-  state[18] = bc[3] ^ (bc[0] & ~bc[4]);
-  state[19] = bc[4] ^ (bc[1] & ~bc[0]);
+  state[15] = bc[0] ^ andnot<chi>(bc[1], bc[2]);
+  state[16] = bc[1] ^ andnot<chi>(bc[2], bc[3]);
+  state[17] = bc[2] ^ andnot<chi>(bc[3], bc[4]);
+  state[18] = bc[3] ^ andnot<chi>(bc[4], bc[0]);
+  state[19] = bc[4] ^ andnot<chi>(bc[0], bc[1]);
 
   t = state[20] ^ d[0];
   bc[3] = std::rotl(t, ROT[15]);
@@ -573,29 +595,199 @@ roundx4(std::span<uint64_t, LANE_CNT> state, const size_t ridx)
   t = state[24] ^ d[4];
   bc[2] = std::rotl(t, ROT[14]);
 
-  state[20] = bc[0] ^ (bc[2] & ~bc[1]);
-  state[21] = bc[1] ^ (bc[3] & ~bc[2]);
-  state[22] = bc[2] ^ (bc[4] & ~bc[3]);
-  state[23] = bc[3] ^ (bc[0] & ~bc[4]);
-  state[24] = bc[4] ^ (bc[1] & ~bc[0]);
+  state[20] = bc[0] ^ andnot<chi>(bc[1], bc[2]);
+  state[21] = bc[1] ^ andnot<chi>(bc[2], bc[3]);
+  state[22] = bc[2] ^ andnot<chi>(bc[3], bc[4]);
+  state[23] = bc[3] ^ andnot<chi>(bc[4], bc[0]);
+  state[24] = bc[4] ^ andnot<chi>(bc[0], bc[1]);
+}
+
+// Applies `roundx4` on `state`, once for each `i`, starting at round `start_at_round`, leaving no loop behind.
+template<chi_t chi, size_t start_at_round, size_t... i>
+static forceinline constexpr void
+roundx4_unrolled(std::array<uint64_t, LANE_CNT>& state, std::index_sequence<i...> /* unused */)
+{
+  (roundx4<chi>(state, start_at_round + (4 * i)), ...);
 }
 
 /**
  * Keccak-f[1600] permutation, applying either 12 or 24 rounds (as requested by template argument) of permutation on state of dimension 5 x 5 x 64 ( = 1600 )
  * -bits, using algorithm 7 defined in section 3.3 of SHA3 specification https://dx.doi.org/10.6028/NIST.FIPS.202.
+ *
+ * This is the portable scalar implementation, built on top of `round` or `roundx4`, as per requested unroll depth, see `UNROLL_DEPTH`, unless the
+ * lane-complementing variant of χ is requested, which always applies two rounds per loop iteration. The `andn` variant must only be used on CPUs supporting
+ * BMI1.
+ */
+template<size_t num_rounds, chi_t chi = chi_t::standard, size_t unroll = UNROLL_DEPTH>
+forceinline constexpr void
+permute_portable(std::array<uint64_t, LANE_CNT>& state)
+  requires(((num_rounds == 12) || (num_rounds == MAX_NUM_ROUNDS)) && is_valid_unroll_depth(unroll))
+{
+  constexpr size_t start_at_round = MAX_NUM_ROUNDS - num_rounds;
+
+  if constexpr (chi == chi_t::lane_complementing) {
+    lane_complementing::permute<num_rounds>(state);
+  } else if constexpr (unroll < 4) {
+#if defined __clang__
+#pragma clang loop unroll(disable)
+#elif defined __GNUG__
+#pragma GCC unroll 1
+#endif
+    for (size_t i = start_at_round; i < MAX_NUM_ROUNDS; i += unroll) {
+      round<chi>(state, i);
+      if constexpr (unroll == 2) {
+        round<chi>(state, i + 1);
+      }
+    }
+  } else if constexpr (unroll == 4) {
+    constexpr size_t STEP_BY = 4;
+
+    static_assert(num_rounds % STEP_BY == 0, "Requested number of keccak-p[1600] rounds need to be a multiple of 4 for manual unrolling to work.");
+
+#if defined __clang__
+#pragma clang loop unroll(disable)
+#elif defined __GNUG__
+#pragma GCC unroll 1
+#endif
+    for (size_t i = start_at_round; i < MAX_NUM_ROUNDS; i += STEP_BY) {
+      roundx4<chi>(state, i);
+    }
+  } else {
+    roundx4_unrolled<chi, start_at_round>(state, std::make_index_sequence<num_rounds / 4>{});
+  }
+}
+
+// Keccak-p[1600] permutation of the scalar backend, which is the bit-interleaved implementation when `BIT_INTERLEAVED` is set, else the portable one.
+template<size_t num_rounds>
+forceinline constexpr void
+permute_scalar(std::array<uint64_t, LANE_CNT>& state)
+  requires((num_rounds == 12) || (num_rounds == MAX_NUM_ROUNDS))
+{
+  if constexpr (BIT_INTERLEAVED) {
+    bit_interleaved::permute<num_rounds>(state);
+  } else {
+    permute_portable<num_rounds>(state);
+  }
+}
+
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+namespace bmi {
+
+// Keccak-p[1600] permutation, using the portable implementation, compiled with BMI1 and BMI2 enabled.
+template<size_t num_rounds, chi_t chi = chi_t::standard>
+SHA3_TARGET_BMI static inline void
+permute(std::array<uint64_t, LANE_CNT>& state)
+{
+  permute_portable<num_rounds, chi>(state);
+}
+
+}
+#endif
+
+/**
+ * Keccak-p[1600] permutation, using the requested backend, which must be supported by the CPU. Except for the scalar backend, it is meant to be called
+ * from functions which are compiled for the same backend, so that the permutation gets inlined into them.
  */
+template<backend_t backend, size_t num_rounds>
+forceinline constexpr void
+permute_using(std::array<uint64_t, LANE_CNT>& state)
+  requires((num_rounds == 12) || (num_rounds == MAX_NUM_ROUNDS))
+{
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+  if constexpr (backend == backend_t::avx512) {
+    avx512::permute<num_rounds>(state);
+  } else if constexpr (backend == backend_t::avx2) {
+    avx2::permute<num_rounds>(state);
+  } else if constexpr (backend == backend_t::bmi) {
+    bmi::permute<num_rounds>(state);
+  } else {
+    permute_scalar<num_rounds>(state);
+  }
+#elif defined(SHA3_HAS_AARCH64_SHA3_BACKEND)
+  if constexpr (backend == backend_t::neon_sha3) {
+    neon_sha3::permute<num_rounds>(state);
+  } else {
+    permute_scalar<num_rounds>(state);
+  }
+#else
+  permute_scalar<num_rounds>(state);
+#endif
+}
+
+// Signature of Keccak-p[1600] permutation, as implemented by each backend.
+using permute_fn_t = void (*)(std::array<uint64_t, LANE_CNT>&);
+
+// Keccak-p[1600] permutation, which is not inlined, using the requested backend.
+template<backend_t backend, size_t num_rounds>
+static inline void
+permute_with(std::array<uint64_t, LANE_CNT>& state)
+{
+  permute_using<backend, num_rounds>(state);
+}
+
+// Returns Keccak-p[1600] permutation, implemented by the requested backend, which must be supported by the CPU.
+template<size_t num_rounds>
+static inline permute_fn_t
+permute_fn(const backend_t backend)
+{
+  switch (backend) {
+    case backend_t::avx512:
+      return permute_with<backend_t::avx512, num_rounds>;
+    case backend_t::avx2:
+      return permute_with<backend_t::avx2, num_rounds>;
+    case backend_t::bmi:
+      return permute_with<backend_t::bmi, num_rounds>;
+    case backend_t::neon_sha3:
+      return permute_with<backend_t::neon_sha3, num_rounds>;
+    case backend_t::scalar:
+      break;
+  }
+
+  return permute_with<backend_t::scalar, num_rounds>;
+}
+
+// Keccak-p[1600] permutation, bound to the active backend, on first call.
 template<size_t num_rounds>
+static inline void
+permute_dispatched(std::array<uint64_t, LANE_CNT>& state)
+{
+  static const permute_fn_t permute_fn_ptr = permute_fn<num_rounds>(active_backend());
+  permute_fn_ptr(state);
+}
+
+/**
+ * Keccak-f[1600] permutation, applying either 12 or 24 rounds (as requested by template argument) of permutation on state of dimension 5 x 5 x 64 ( = 1600 )
+ * -bits. At runtime, it uses the backend bound to the CPU, see `active_backend`, while compile-time evaluation, and targets without SIMD backends, use
+ * `permute_scalar`.
+ *
+ * Requesting a non-standard variant of χ step mapping function, see `chi_t`, bypasses backend selection and runs the portable scalar implementation, using
+ * that variant. The `andn` variant falls back to the standard one, on CPUs not supporting BMI1.
+ */
+template<size_t num_rounds, chi_t chi = chi_t::standard>
 forceinline constexpr void
 permute(std::array<uint64_t, LANE_CNT>& state)
   requires((num_rounds == 12) || (num_rounds == MAX_NUM_ROUNDS))
 {
-  constexpr size_t start_at_round = MAX_NUM_ROUNDS - num_rounds;
-  constexpr size_t STEP_BY = 4;
+  if constexpr (chi == chi_t::lane_complementing) {
+    permute_portable<num_rounds, chi>(state);
+  } else if constexpr (chi == chi_t::andn) {
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+    if (!std::is_constant_evaluated() && cpu_features::has_bmi()) {
+      bmi::permute<num_rounds, chi>(state);
+      return;
+    }
+#endif
 
-  static_assert(num_rounds % STEP_BY == 0, "Requested number of keccak-p[1600] rounds need to be a multiple of 4 for manual unrolling to work.");
+    permute<num_rounds>(state);
+  } else {
+#if defined(SHA3_HAS_SIMD_BACKENDS)
+    if (!std::is_constant_evaluated()) {
+      permute_dispatched<num_rounds>(state);
+      return;
+    }
+#endif
 
-  for (size_t i = start_at_round; i < MAX_NUM_ROUNDS; i += STEP_BY) {
-    roundx4(state, i);
+    permute_scalar<num_rounds>(state);
   }
 }
 
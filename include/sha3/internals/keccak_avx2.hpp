@@ -0,0 +1,205 @@
+#pragma once
+#include "sha3/internals/cpu_features.hpp"
+#include "sha3/internals/force_inline.hpp"
+#include "sha3/internals/keccak_constants.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+#include <immintrin.h>
+
+// Single-state AVX2 backend of Keccak-p[1600, 12] and Keccak-p[1600, 24] permutation
+namespace keccak::avx2 {
+
+// Only `may_alias` attribute of `__m256i` is dropped when used as element type of `std::array`, which is harmless here.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wignored-attributes"
+
+/**
+ * Keccak-f[1600] state is held in seven 256 -bit registers, where lane A[y][x] lives at index `5 * y + x` of the state array.
+ *
+ * - Register 0 holds A[0][0], broadcasted to all four words.
+ * - Register 1 holds remaining lanes of row 0 i.e. A[0][1..4].
+ * - Registers 2 to 6 hold rows 1 to 4, s.t. word `j` of each of them belongs to row 2, 4, 1 or 3, for j = 0, 1, 2 or 3, respectively. Register 2 holds
+ *   column 0 of those rows, while registers 3 to 6 hold four diagonals of the remaining 4 x 4 lanes.
+ *
+ * With this arrangement, π step mapping function moves register 1 to 2 and 5 to 6 without touching any word, while the other four moves need a single
+ * `vpermq` each. And as each row lives in a single word position, across registers 2 to 6, χ step mapping function is computed using blends only.
+ */
+static constexpr std::array<std::array<size_t, 4>, 7> LAYOUT{ { { 0, 0, 0, 0 },
+                                                                 { 1, 2, 3, 4 },
+                                                                 { 10, 20, 5, 15 },
+                                                                 { 14, 23, 7, 16 },
+                                                                 { 11, 22, 8, 19 },
+                                                                 { 13, 21, 9, 17 },
+                                                                 { 12, 24, 6, 18 } } };
+
+// Rotation offsets of ρ step mapping function, for lanes A[1][1], A[2][2], A[3][3] and A[4][4], which is the word order of register 6, after applying π.
+static constexpr std::array<size_t, 4> DIAGONAL{ 6, 12, 18, 24 };
+
+// Cross-lane permutation of 64 -bit words s.t. word `i` of the result is word `(imm >> (2 * i)) & 3` of `x`, using `vpermq`.
+template<int imm>
+SHA3_TARGET_AVX2 static forceinline __m256i
+permute4x64(const __m256i x)
+{
+  return _mm256_permute4x64_epi64(x, imm);
+}
+
+// Returns a 256 -bit register s.t. its word `j` is taken from word `j` of `w{j}`, using `vpblendd`.
+SHA3_TARGET_AVX2 static forceinline __m256i
+select(const __m256i w0, const __m256i w1, const __m256i w2, const __m256i w3)
+{
+  return _mm256_blend_epi32(_mm256_blend_epi32(w0, w1, 0b00001100), _mm256_blend_epi32(w2, w3, 0b11000000), 0b11110000);
+}
+
+// Returns a 256 -bit register s.t. its word `j` is lane `lanes[j]` of `state`. Each word comes from an unaligned load, which places the requested lane at
+// word position `j`, and those are blended together. Loads never cross the end of `state`.
+SHA3_TARGET_AVX2 static forceinline __m256i
+gather(const std::array<uint64_t, LANE_CNT>& state, const std::array<size_t, 4>& lanes)
+{
+  std::array<__m256i, 4> w{};
+
+  for (size_t j = 0; j < w.size(); j++) {
+    const size_t off = lanes[j] - j;
+
+    if ((off + w.size()) <= state.size()) {
+      w[j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[off])); // NOLINT
+    } else {
+      w[j] = _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[off]))); // NOLINT
+    }
+  }
+
+  return select(w[0], w[1], w[2], w[3]);
+}
+
+// Leftwards circular rotation of each 64 -bit word of `x` by 1 -bit.
+SHA3_TARGET_AVX2 static forceinline __m256i
+rotl1(const __m256i x)
+{
+  return _mm256_or_si256(_mm256_add_epi64(x, x), _mm256_srli_epi64(x, 63));
+}
+
+// Leftwards circular rotation of each 64 -bit word of `x` by ρ step mapping rotation offset of lane `lanes[i]`, using variable shifts.
+SHA3_TARGET_AVX2 static forceinline __m256i
+rho(const __m256i x, const std::array<size_t, 4>& lanes)
+{
+  const __m256i lshift = _mm256_setr_epi64x(static_cast<long long>(ROT[lanes[0]]),
+                                             static_cast<long long>(ROT[lanes[1]]),
+                                             static_cast<long long>(ROT[lanes[2]]),
+                                             static_cast<long long>(ROT[lanes[3]]));
+  const __m256i rshift = _mm256_sub_epi64(_mm256_set1_epi64x(64), lshift);
+
+  return _mm256_or_si256(_mm256_sllv_epi64(x, lshift), _mm256_srlv_epi64(x, rshift));
+}
+
+/**
+ * Keccak-f[1600] round function, operating on a state held as seven 256 -bit registers, see `LAYOUT`. `round_constant` is the one for the round being
+ * applied.
+ *
+ * See section 3.3 of https://dx.doi.org/10.6028/NIST.FIPS.202.
+ */
+SHA3_TARGET_AVX2 static forceinline void
+round(std::array<__m256i, 7>& a, const uint64_t round_constant)
+{
+  // θ step mapping. Column parities of column 1 to 4 are computed after bringing words of register 3, 5 and 6 in column order.
+  const __m256i c14 = _mm256_xor_si256(_mm256_xor_si256(a[1], a[4]),
+                                       _mm256_xor_si256(permute4x64<0b00011011>(a[3]), _mm256_xor_si256(permute4x64<0b10001101>(a[5]), permute4x64<0b01110010>(a[6]))));
+
+  __m256i c00 = _mm256_xor_si256(a[2], permute4x64<0b01001110>(a[2]));
+  c00 = _mm256_xor_si256(a[0], _mm256_xor_si256(c00, _mm256_shuffle_epi32(c00, 0b01001110)));
+
+  const __m256i c4123 = permute4x64<0b10010011>(c14);
+  const __m256i c0123 = _mm256_blend_epi32(c4123, c00, 0b00000011);
+  const __m256i c2340 = _mm256_blend_epi32(permute4x64<0b00111001>(c14), c00, 0b11000000);
+
+  const __m256i d00 = permute4x64<0b00000000>(_mm256_xor_si256(c4123, rotl1(c14)));
+  const __m256i d14 = _mm256_xor_si256(c0123, rotl1(c2340));
+
+  // θ (continued) and ρ step mapping. Register 6 is moved to its place after π, before applying θ, so that it agrees with word order of `d14`.
+  a[0] = _mm256_xor_si256(a[0], d00);
+  a[1] = rho(_mm256_xor_si256(a[1], d14), LAYOUT[1]);
+  a[2] = rho(_mm256_xor_si256(a[2], d00), LAYOUT[2]);
+  a[3] = rho(_mm256_xor_si256(a[3], permute4x64<0b00011011>(d14)), LAYOUT[3]);
+  a[4] = rho(_mm256_xor_si256(a[4], d14), LAYOUT[4]);
+  a[5] = rho(_mm256_xor_si256(a[5], permute4x64<0b01110010>(d14)), LAYOUT[5]);
+  a[6] = rho(_mm256_xor_si256(permute4x64<0b01110010>(a[6]), d14), DIAGONAL);
+
+  // π step mapping
+  const __m256i a6 = a[6];
+  a[6] = a[5];
+  a[5] = permute4x64<0b00011011>(a[4]);
+  a[4] = permute4x64<0b01110010>(a[3]);
+  a[3] = permute4x64<0b10001101>(a[2]);
+  a[2] = a[1];
+  a[1] = a6;
+
+  // χ step mapping, on row 0
+  const __m256i x1 = _mm256_blend_epi32(permute4x64<0b00111001>(a[1]), a[0], 0b11000000);
+  const __m256i x2 = _mm256_blend_epi32(permute4x64<0b00001110>(a[1]), a[0], 0b00110000);
+
+  a[0] = _mm256_xor_si256(a[0], permute4x64<0b00000000>(_mm256_andnot_si256(a[1], x1)));
+  a[1] = _mm256_xor_si256(a[1], _mm256_andnot_si256(x1, x2));
+
+  // χ step mapping, on row 1 to 4. As word `j` of register 2 to 6 belongs to the same row, those rows are first transposed into five columns, using
+  // blends only, so that χ can be applied on all four rows at once.
+  const __m256i col0 = a[2];
+  const __m256i col1 = select(a[4], a[5], a[6], a[3]);
+  const __m256i col2 = select(a[6], a[4], a[3], a[5]);
+  const __m256i col3 = select(a[5], a[3], a[4], a[6]);
+  const __m256i col4 = select(a[3], a[6], a[5], a[4]);
+
+  const __m256i chi0 = _mm256_xor_si256(col0, _mm256_andnot_si256(col1, col2));
+  const __m256i chi1 = _mm256_xor_si256(col1, _mm256_andnot_si256(col2, col3));
+  const __m256i chi2 = _mm256_xor_si256(col2, _mm256_andnot_si256(col3, col4));
+  const __m256i chi3 = _mm256_xor_si256(col3, _mm256_andnot_si256(col4, col0));
+  const __m256i chi4 = _mm256_xor_si256(col4, _mm256_andnot_si256(col0, col1));
+
+  a[2] = chi0;
+  a[3] = select(chi4, chi3, chi2, chi1);
+  a[4] = select(chi1, chi2, chi3, chi4);
+  a[5] = select(chi3, chi1, chi4, chi2);
+  a[6] = select(chi2, chi4, chi1, chi3);
+
+  // ι step mapping
+  a[0] = _mm256_xor_si256(a[0], _mm256_set1_epi64x(static_cast<long long>(round_constant)));
+}
+
+/**
+ * Applies last `num_rounds` rounds of Keccak-f[1600] permutation on a single state, which is kept in seven 256 -bit registers, see `LAYOUT`, for the
+ * whole duration of the permutation.
+ */
+template<size_t num_rounds>
+SHA3_TARGET_AVX2 static inline void
+permute(std::array<uint64_t, LANE_CNT>& state)
+{
+  std::array<__m256i, 7> a{};
+
+  a[0] = _mm256_set1_epi64x(static_cast<long long>(state[0]));
+  a[1] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[1])); // NOLINT
+  for (size_t k = 2; k < a.size(); k++) {
+    a[k] = gather(state, LAYOUT[k]);
+  }
+
+  for (size_t i = MAX_NUM_ROUNDS - num_rounds; i < MAX_NUM_ROUNDS; i++) {
+    round(a, RC[i]);
+  }
+
+  state[0] = static_cast<uint64_t>(_mm_cvtsi128_si64(_mm256_castsi256_si128(a[0])));
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[1]), a[1]); // NOLINT
+  for (size_t k = 2; k < a.size(); k++) {
+    std::array<uint64_t, 4> words{};
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(words.data()), a[k]); // NOLINT
+
+    const auto& lanes = LAYOUT[k];
+    for (size_t j = 0; j < words.size(); j++) {
+      state[lanes[j]] = words[j];
+    }
+  }
+}
+
+#pragma GCC diagnostic pop
+
+}
+
+#endif
@@ -0,0 +1,153 @@
+#pragma once
+#include "sha3/internals/cpu_features.hpp"
+#include "sha3/internals/force_inline.hpp"
+#include "sha3/internals/keccak_constants.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+#include <immintrin.h>
+
+// Single-state AVX-512 backend of Keccak-p[1600, 12] and Keccak-p[1600, 24] permutation
+namespace keccak::avx512 {
+
+// Only `may_alias` attribute of `__m512i` is dropped when used as element type of `std::array`, which is harmless here. And GCC falsely reports
+// self-initialized `_mm512_undefined_epi32()`, used inside AVX-512 intrinsics, as (maybe) uninitialized, when those get inlined into callers.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wignored-attributes"
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#if !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+// Truth tables, for `vpternlogq`, computing `a ^ b ^ c` and `a ^ (~b & c)`, respectively.
+static constexpr int TERNLOG_XOR3 = 0x96;
+static constexpr int TERNLOG_CHI = 0xd2;
+
+// Mask selecting five lanes of a row of Keccak-f[1600] state, living in lower five 64 -bit words of a 512 -bit register.
+static constexpr __mmask8 ROW_MASK = 0b00011111;
+
+/**
+ * Lane index vectors, for `vpermq` and `vpermt2q`, which implement π step mapping function, when state is held as five 512 -bit registers, one row each.
+ * π moves lane (x, (x + 3y) mod 5) to (y, x), so row `y` of the permuted state collects one lane from each of the five rows of input state. Lanes 0 and 1
+ * are picked from rows 0 and 1, lanes 2 and 3 from rows 2 and 3 and finally lane 4 from row 4.
+ *
+ * See section 3.2.3 of https://dx.doi.org/10.6028/NIST.FIPS.202.
+ */
+static consteval std::array<std::array<int64_t, 8>, 5>
+compute_pi_index(const size_t first_row, const size_t lane_cnt)
+{
+  std::array<std::array<int64_t, 8>, 5> res{};
+
+  for (size_t y = 0; y < 5; y++) {
+    for (size_t k = 0; k < lane_cnt; k++) {
+      const size_t x = first_row + k;
+      res[y][x] = static_cast<int64_t>((k * 8) + ((x + (3 * y)) % 5));
+    }
+  }
+
+  return res;
+}
+
+static constexpr auto PI_INDEX_ROW01 = compute_pi_index(0, 2);
+static constexpr auto PI_INDEX_ROW23 = compute_pi_index(2, 2);
+static constexpr auto PI_INDEX_ROW4 = compute_pi_index(4, 1);
+
+// Builds a 512 -bit register from eight 64 -bit words, where `words[0]` goes to least significant word.
+SHA3_TARGET_AVX512 static forceinline __m512i
+setr(const std::array<int64_t, 8>& words)
+{
+  return _mm512_loadu_si512(words.data());
+}
+
+/**
+ * Keccak-f[1600] round function, operating on a state held as five 512 -bit registers s.t. register `y` holds lanes A[y][0..4] in its lower five words.
+ * θ and χ are computed using three-input `vpternlogq`, ρ uses per-lane rotations `vprolvq` and π is a gather of one lane from each row, built using
+ * `vpermt2q`.
+ *
+ * See section 3.3 of https://dx.doi.org/10.6028/NIST.FIPS.202.
+ */
+SHA3_TARGET_AVX512 static forceinline void
+round(std::array<__m512i, 5>& rows, const size_t ridx)
+{
+  const __m512i x_minus_1 = _mm512_setr_epi64(4, 0, 1, 2, 3, 5, 6, 7);
+  const __m512i x_plus_1 = _mm512_setr_epi64(1, 2, 3, 4, 0, 5, 6, 7);
+  const __m512i x_plus_2 = _mm512_setr_epi64(2, 3, 4, 0, 1, 5, 6, 7);
+
+  // θ step mapping
+  __m512i c = _mm512_ternarylogic_epi64(rows[0], rows[1], rows[2], TERNLOG_XOR3);
+  c = _mm512_ternarylogic_epi64(c, rows[3], rows[4], TERNLOG_XOR3);
+
+  const __m512i c_prev = _mm512_permutexvar_epi64(x_minus_1, c);
+  const __m512i c_next = _mm512_rol_epi64(_mm512_permutexvar_epi64(x_plus_1, c), 1);
+
+  // θ (continued) and ρ step mapping
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 5
+#endif
+  for (size_t y = 0; y < 5; y++) {
+    const __m512i rho = _mm512_setr_epi64(ROT[(5 * y) + 0], ROT[(5 * y) + 1], ROT[(5 * y) + 2], ROT[(5 * y) + 3], ROT[(5 * y) + 4], 0, 0, 0);
+    rows[y] = _mm512_rolv_epi64(_mm512_ternarylogic_epi64(rows[y], c_prev, c_next, TERNLOG_XOR3), rho);
+  }
+
+  // π step mapping
+  std::array<__m512i, 5> b{};
+
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 5
+#endif
+  for (size_t y = 0; y < 5; y++) {
+    const __m512i lanes01 = _mm512_permutex2var_epi64(rows[0], setr(PI_INDEX_ROW01[y]), rows[1]);
+    const __m512i lanes23 = _mm512_permutex2var_epi64(rows[2], setr(PI_INDEX_ROW23[y]), rows[3]);
+    const __m512i lanes0123 = _mm512_mask_blend_epi64(0b00001100, lanes01, lanes23);
+
+    b[y] = _mm512_mask_permutexvar_epi64(lanes0123, 0b00010000, setr(PI_INDEX_ROW4[y]), rows[4]);
+  }
+
+  // χ step mapping
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 5
+#endif
+  for (size_t y = 0; y < 5; y++) {
+    rows[y] = _mm512_ternarylogic_epi64(b[y], _mm512_permutexvar_epi64(x_plus_1, b[y]), _mm512_permutexvar_epi64(x_plus_2, b[y]), TERNLOG_CHI);
+  }
+
+  // ι step mapping
+  rows[0] = _mm512_xor_si512(rows[0], _mm512_maskz_loadu_epi64(0b00000001, &RC[ridx]));
+}
+
+/**
+ * Applies last `num_rounds` rounds of Keccak-f[1600] permutation on a single state, which is kept in five 512 -bit registers, one row each, for the
+ * whole duration of the permutation.
+ */
+template<size_t num_rounds>
+SHA3_TARGET_AVX512 static inline void
+permute(std::array<uint64_t, LANE_CNT>& state)
+{
+  std::array<__m512i, 5> rows{};
+
+  for (size_t y = 0; y < 5; y++) {
+    rows[y] = _mm512_maskz_loadu_epi64(ROW_MASK, &state[5 * y]);
+  }
+
+  for (size_t i = MAX_NUM_ROUNDS - num_rounds; i < MAX_NUM_ROUNDS; i++) {
+    round(rows, i);
+  }
+
+  for (size_t y = 0; y < 5; y++) {
+    _mm512_mask_storeu_epi64(&state[5 * y], ROW_MASK, rows[y]);
+  }
+}
+
+#pragma GCC diagnostic pop
+
+}
+
+#endif
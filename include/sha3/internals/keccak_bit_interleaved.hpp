@@ -0,0 +1,194 @@
+#pragma once
+#include "sha3/internals/force_inline.hpp"
+#include "sha3/internals/keccak_constants.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// Bit-interleaved implementation of Keccak-p[1600, 12] and Keccak-p[1600, 24] permutation, for 32 -bit targets
+namespace keccak::bit_interleaved {
+
+/**
+ * A 64 -bit lane, kept in bit-interleaved form, as two 32 -bit words, s.t. bit `i` of `even` is bit `2 * i` of the lane and bit `i` of `odd` is bit
+ * `2 * i + 1` of the lane. With this representation, rotation of a lane becomes two 32 -bit rotations, instead of four shifts and two ORs, on targets
+ * lacking 64 -bit registers. See section 2.1 of "Keccak implementation overview", https://keccak.team/files/Keccak-implementation-3.2.pdf.
+ */
+struct lane_t
+{
+  uint32_t even = 0;
+  uint32_t odd = 0;
+};
+
+forceinline constexpr lane_t
+operator^(const lane_t a, const lane_t b)
+{
+  return { a.even ^ b.even, a.odd ^ b.odd };
+}
+
+// Computes `a ^ (~b & c)`, which is χ step mapping function applied on a single lane, on each half.
+forceinline constexpr lane_t
+chi(const lane_t a, const lane_t b, const lane_t c)
+{
+  return { a.even ^ (~b.even & c.even), a.odd ^ (~b.odd & c.odd) };
+}
+
+// Leftwards circular rotation of a bit-interleaved lane by `r` -bits. Rotation by an odd offset also swaps both halves.
+template<size_t r>
+forceinline constexpr lane_t
+rotl(const lane_t x)
+{
+  if constexpr (r % 2 == 0) {
+    return { std::rotl(x.even, static_cast<int>(r / 2)), std::rotl(x.odd, static_cast<int>(r / 2)) };
+  } else {
+    return { std::rotl(x.odd, static_cast<int>((r + 1) / 2)), std::rotl(x.even, static_cast<int>(r / 2)) };
+  }
+}
+
+// Brings a 64 -bit lane into bit-interleaved form, gathering even bits into the lower half and odd bits into the upper half, using five delta swaps.
+forceinline constexpr lane_t
+to_bit_interleaved(uint64_t x)
+{
+  uint64_t t = 0;
+
+  t = (x ^ (x >> 1U)) & UINT64_C(0x2222222222222222);
+  x ^= t ^ (t << 1U);
+  t = (x ^ (x >> 2U)) & UINT64_C(0x0c0c0c0c0c0c0c0c);
+  x ^= t ^ (t << 2U);
+  t = (x ^ (x >> 4U)) & UINT64_C(0x00f000f000f000f0);
+  x ^= t ^ (t << 4U);
+  t = (x ^ (x >> 8U)) & UINT64_C(0x0000ff000000ff00);
+  x ^= t ^ (t << 8U);
+  t = (x ^ (x >> 16U)) & UINT64_C(0x00000000ffff0000);
+  x ^= t ^ (t << 16U);
+
+  return { static_cast<uint32_t>(x), static_cast<uint32_t>(x >> 32U) };
+}
+
+// Brings a bit-interleaved lane back into its 64 -bit form, undoing `to_bit_interleaved`, by applying same delta swaps, in reverse order.
+forceinline constexpr uint64_t
+from_bit_interleaved(const lane_t lane)
+{
+  uint64_t x = (static_cast<uint64_t>(lane.odd) << 32U) | lane.even;
+  uint64_t t = 0;
+
+  t = (x ^ (x >> 16U)) & UINT64_C(0x00000000ffff0000);
+  x ^= t ^ (t << 16U);
+  t = (x ^ (x >> 8U)) & UINT64_C(0x0000ff000000ff00);
+  x ^= t ^ (t << 8U);
+  t = (x ^ (x >> 4U)) & UINT64_C(0x00f000f000f000f0);
+  x ^= t ^ (t << 4U);
+  t = (x ^ (x >> 2U)) & UINT64_C(0x0c0c0c0c0c0c0c0c);
+  x ^= t ^ (t << 2U);
+  t = (x ^ (x >> 1U)) & UINT64_C(0x2222222222222222);
+  x ^= t ^ (t << 1U);
+
+  return x;
+}
+
+// Compile-time compute bit-interleaved form of Keccak-f[1600] round constants.
+static consteval std::array<lane_t, MAX_NUM_ROUNDS>
+compute_rcs()
+{
+  std::array<lane_t, MAX_NUM_ROUNDS> res{};
+
+  for (size_t i = 0; i < MAX_NUM_ROUNDS; i++) {
+    res[i] = to_bit_interleaved(RC[i]);
+  }
+
+  return res;
+}
+
+// Round constants, in bit-interleaved form, to be XORed with lane (0, 0) of Keccak-f[1600] permutation state.
+static constexpr std::array<lane_t, MAX_NUM_ROUNDS> RC_BI = compute_rcs();
+
+// Fused θ (continued), ρ and π step mapping functions, s.t. lane `i` of `b` is lane `PERM[i]` of `state`, after θ and ρ. Rotation offsets are
+// compile-time constants.
+template<size_t... i>
+static forceinline constexpr void
+rho_pi(std::array<lane_t, LANE_CNT>& b, const std::array<lane_t, LANE_CNT>& state, const std::array<lane_t, 5>& d, std::index_sequence<i...> /* unused */)
+{
+  ((b[i] = rotl<ROT[PERM[i]]>(state[PERM[i]] ^ d[PERM[i] % 5])), ...);
+}
+
+/**
+ * Keccak-f[1600] round function, applying all five step mapping functions on a state, kept in bit-interleaved form. `ridx` is the index of the round being
+ * applied.
+ *
+ * See section 3.3 of https://dx.doi.org/10.6028/NIST.FIPS.202.
+ */
+static forceinline constexpr void
+round(std::array<lane_t, LANE_CNT>& state, const size_t ridx)
+{
+  std::array<lane_t, 5> c{};
+  std::array<lane_t, 5> d{};
+  std::array<lane_t, LANE_CNT> b{};
+
+  // θ step mapping
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 5
+#endif
+  for (size_t x = 0; x < c.size(); x++) {
+    c[x] = state[x] ^ state[x + 5] ^ state[x + 10] ^ state[x + 15] ^ state[x + 20];
+  }
+
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 5
+#endif
+  for (size_t x = 0; x < d.size(); x++) {
+    d[x] = c[(x + 4) % 5] ^ rotl<1>(c[(x + 1) % 5]);
+  }
+
+  // ρ and π step mapping
+  rho_pi(b, state, d, std::make_index_sequence<LANE_CNT>{});
+
+  // χ step mapping
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 25
+#endif
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    const size_t row = i - (i % 5);
+    state[i] = chi(b[i], b[row + ((i + 1) % 5)], b[row + ((i + 2) % 5)]);
+  }
+
+  // ι step mapping
+  state[0] = state[0] ^ RC_BI[ridx];
+}
+
+/**
+ * Applies last `num_rounds` rounds of Keccak-f[1600] permutation on a single state, which is brought into bit-interleaved form, before the first round, and
+ * back out of it, after the last round. Only 32 -bit operations are used by the rounds, which is what 32 -bit targets execute natively, while conversion
+ * costs five delta swaps per lane, in either direction.
+ */
+template<size_t num_rounds>
+forceinline constexpr void
+permute(std::array<uint64_t, LANE_CNT>& state)
+{
+  std::array<lane_t, LANE_CNT> lanes{};
+
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    lanes[i] = to_bit_interleaved(state[i]);
+  }
+
+#if defined __clang__
+#pragma clang loop unroll(disable)
+#elif defined __GNUG__
+#pragma GCC unroll 1
+#endif
+  for (size_t i = MAX_NUM_ROUNDS - num_rounds; i < MAX_NUM_ROUNDS; i++) {
+    round(lanes, i);
+  }
+
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    state[i] = from_bit_interleaved(lanes[i]);
+  }
+}
+
+}
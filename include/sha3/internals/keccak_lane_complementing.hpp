@@ -0,0 +1,188 @@
+#pragma once
+#include "sha3/internals/force_inline.hpp"
+#include "sha3/internals/keccak_constants.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// Lane-complementing implementation of Keccak-p[1600, 12] and Keccak-p[1600, 24] permutation
+namespace keccak::lane_complementing {
+
+/**
+ * Lanes which are kept complemented, all through the permutation, i.e. A[0][1], A[0][2], A[1][3], A[2][2], A[3][2] and A[4][0], where lane A[y][x] lives
+ * at index `5 * y + x` of the state array. With this choice of lanes, four out of five χ lanes of every row are computed using a single AND or OR, and only
+ * one NOT remains per row, instead of five. This is the "bebigokimisa" lane complementing transform, described in "Keccak implementation overview",
+ * see https://keccak.team/files/Keccak-implementation-3.2.pdf.
+ */
+static constexpr std::array<bool, LANE_CNT> MASK{ false, true,  true,  false, false, // A[0][0..4]
+                                                  false, false, false, true,  false, // A[1][0..4]
+                                                  false, false, true,  false, false, // A[2][0..4]
+                                                  false, false, true,  false, false, // A[3][0..4]
+                                                  true,  false, false, false, false }; // A[4][0..4]
+
+// Whether column parity C[x] and θ effect D[x] come out complemented, when computed from a state which has `MASK` lanes complemented.
+static consteval std::array<bool, 5>
+compute_theta_mask()
+{
+  std::array<bool, 5> c{};
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    c[i % 5] ^= MASK[i];
+  }
+
+  std::array<bool, 5> d{};
+  for (size_t x = 0; x < d.size(); x++) {
+    d[x] = c[(x + 4) % 5] ^ c[(x + 1) % 5];
+  }
+
+  return d;
+}
+
+static constexpr auto THETA_MASK = compute_theta_mask();
+
+// Whether lane `i` is complemented, after applying θ, ρ and π step mapping functions on a state which has `MASK` lanes complemented.
+static consteval std::array<bool, LANE_CNT>
+compute_pi_mask()
+{
+  std::array<bool, LANE_CNT> res{};
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    res[i] = MASK[PERM[i]] ^ THETA_MASK[PERM[i] % 5];
+  }
+
+  return res;
+}
+
+static constexpr auto PI_MASK = compute_pi_mask();
+
+// Complements lanes of `state`, selected by `MASK`. Applying it twice leaves the state unchanged.
+forceinline constexpr void
+complement(std::array<uint64_t, LANE_CNT>& state)
+{
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 25
+#endif
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    if (MASK[i]) {
+      state[i] = ~state[i];
+    }
+  }
+}
+
+/**
+ * χ step mapping function, producing lane `i` of a row, i.e. `b[x] ^ (~b[x + 1] & b[x + 2])` with x = i mod 5, when both input and output lanes may be
+ * complemented. Depending on which of those are complemented, it picks an equivalent expression, using as few NOTs as possible. When two lanes of a row
+ * need a NOT, both complement the same input lane, so that the NOT is computed only once.
+ */
+template<size_t i>
+static forceinline constexpr uint64_t
+chi(const std::array<uint64_t, 5>& b)
+{
+  constexpr size_t row = i - (i % 5);
+  constexpr size_t x0 = i % 5;
+  constexpr size_t x1 = (i + 1) % 5;
+  constexpr size_t x2 = (i + 2) % 5;
+  constexpr bool flip = PI_MASK[i] != MASK[i];
+
+  if constexpr (PI_MASK[row + x1] && !PI_MASK[row + x2]) {
+    return flip ? (~b[x0] ^ (b[x1] & b[x2])) : (b[x0] ^ (b[x1] & b[x2]));
+  } else if constexpr (!PI_MASK[row + x1] && PI_MASK[row + x2]) {
+    return flip ? (b[x0] ^ (b[x1] | b[x2])) : (~b[x0] ^ (b[x1] | b[x2]));
+  } else if constexpr (!PI_MASK[row + x1] && !PI_MASK[row + x2]) {
+    return flip ? (b[x0] ^ (b[x1] | ~b[x2])) : (b[x0] ^ (~b[x1] & b[x2]));
+  } else {
+    return flip ? (b[x0] ^ (~b[x1] | b[x2])) : (b[x0] ^ (b[x1] & ~b[x2]));
+  }
+}
+
+// Fused θ (continued), ρ and π step mapping functions, followed by χ, producing row `y` of the output state. Rotation offsets are compile-time constants.
+template<size_t y, size_t... x>
+static forceinline constexpr void
+rho_pi_chi_row(std::array<uint64_t, LANE_CNT>& out,
+               const std::array<uint64_t, LANE_CNT>& in,
+               const std::array<uint64_t, 5>& d,
+               std::index_sequence<x...> /* unused */)
+{
+  std::array<uint64_t, 5> b{};
+
+  ((b[x] = std::rotl(in[PERM[(5 * y) + x]] ^ d[PERM[(5 * y) + x] % 5], ROT[PERM[(5 * y) + x]])), ...);
+  ((out[(5 * y) + x] = chi<(5 * y) + x>(b)), ...);
+}
+
+// Applies `rho_pi_chi_row` on each row of the state.
+template<size_t... y>
+static forceinline constexpr void
+rho_pi_chi(std::array<uint64_t, LANE_CNT>& out,
+           const std::array<uint64_t, LANE_CNT>& in,
+           const std::array<uint64_t, 5>& d,
+           std::index_sequence<y...> /* unused */)
+{
+  (rho_pi_chi_row<y>(out, in, d, std::make_index_sequence<5>{}), ...);
+}
+
+/**
+ * Keccak-f[1600] round function, applying all five step mapping functions on `in`, writing the result to `out`. Input state must have `MASK` lanes
+ * complemented, and so does the output state, so that consecutive rounds can be applied without touching the representation. `ridx` is the index of the
+ * round being applied.
+ *
+ * See section 3.3 of https://dx.doi.org/10.6028/NIST.FIPS.202.
+ */
+static forceinline constexpr void
+round(std::array<uint64_t, LANE_CNT>& out, const std::array<uint64_t, LANE_CNT>& in, const size_t ridx)
+{
+  std::array<uint64_t, 5> c{};
+  std::array<uint64_t, 5> d{};
+
+  // θ step mapping
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 5
+#endif
+  for (size_t x = 0; x < c.size(); x++) {
+    c[x] = in[x] ^ in[x + 5] ^ in[x + 10] ^ in[x + 15] ^ in[x + 20];
+  }
+
+
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 5
+#endif
+  for (size_t x = 0; x < d.size(); x++) {
+    d[x] = c[(x + 4) % 5] ^ std::rotl(c[(x + 1) % 5], 1);
+  }
+
+  // ρ, π and χ step mapping
+  rho_pi_chi(out, in, d, std::make_index_sequence<5>{});
+
+  // ι step mapping, which commutes with complementing lane A[0][0]
+  out[0] ^= RC[ridx];
+}
+
+/**
+ * Applies last `num_rounds` rounds of Keccak-f[1600] permutation on a single state, which is brought into lane-complemented representation, before the
+ * first round, and out of it, after the last round. That costs twelve NOTs per permutation, while saving twenty NOTs per round. Rounds are applied in
+ * pairs, going back and forth between `state` and a temporary state.
+ */
+template<size_t num_rounds>
+forceinline constexpr void
+permute(std::array<uint64_t, LANE_CNT>& state)
+{
+  static_assert(num_rounds % 2 == 0, "Requested number of keccak-p[1600] rounds need to be a multiple of 2, as rounds are applied in pairs.");
+
+  std::array<uint64_t, LANE_CNT> tmp{};
+
+  complement(state);
+
+  for (size_t i = MAX_NUM_ROUNDS - num_rounds; i < MAX_NUM_ROUNDS; i += 2) {
+    round(tmp, state, i);
+    round(state, tmp, i + 1);
+  }
+
+  complement(state);
+}
+
+}
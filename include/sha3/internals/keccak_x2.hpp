@@ -0,0 +1,198 @@
+#pragma once
+#include "sha3/internals/cpu_features.hpp"
+#include "sha3/internals/force_inline.hpp"
+#include "sha3/internals/keccak.hpp"
+#include "sha3/internals/keccak_neon_sha3.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+// 2-way multi-buffer Keccak-p[1600, 12] and Keccak-p[1600, 24] permutation
+namespace keccak {
+
+// # -of independent Keccak-f[1600] states, permuted together by `permute_x2`.
+static constexpr size_t X2_STATE_CNT = 2;
+
+namespace x2 {
+
+// Fused θ (continued), ρ, π and χ step mapping functions, producing row `y` of both output states. Every statement on the first state is followed by the
+// same statement on the second one. Rotation offsets are compile-time constants.
+template<size_t y, size_t... x>
+static forceinline constexpr void
+rho_pi_chi_row(std::array<uint64_t, LANE_CNT>& out0,
+               std::array<uint64_t, LANE_CNT>& out1,
+               const std::array<uint64_t, LANE_CNT>& in0,
+               const std::array<uint64_t, LANE_CNT>& in1,
+               const std::array<uint64_t, 5>& d0,
+               const std::array<uint64_t, 5>& d1,
+               std::index_sequence<x...> /* unused */)
+{
+  std::array<uint64_t, 5> b0{};
+  std::array<uint64_t, 5> b1{};
+
+  ((b0[x] = std::rotl(in0[PERM[(5 * y) + x]] ^ d0[PERM[(5 * y) + x] % 5], ROT[PERM[(5 * y) + x]]),
+    b1[x] = std::rotl(in1[PERM[(5 * y) + x]] ^ d1[PERM[(5 * y) + x] % 5], ROT[PERM[(5 * y) + x]])),
+   ...);
+  ((out0[(5 * y) + x] = b0[x] ^ (~b0[(x + 1) % 5] & b0[(x + 2) % 5]), out1[(5 * y) + x] = b1[x] ^ (~b1[(x + 1) % 5] & b1[(x + 2) % 5])), ...);
+}
+
+// Applies `rho_pi_chi_row` on each row of both states.
+template<size_t... y>
+static forceinline constexpr void
+rho_pi_chi(std::array<uint64_t, LANE_CNT>& out0,
+           std::array<uint64_t, LANE_CNT>& out1,
+           const std::array<uint64_t, LANE_CNT>& in0,
+           const std::array<uint64_t, LANE_CNT>& in1,
+           const std::array<uint64_t, 5>& d0,
+           const std::array<uint64_t, 5>& d1,
+           std::index_sequence<y...> /* unused */)
+{
+  (rho_pi_chi_row<y>(out0, out1, in0, in1, d0, d1, std::make_index_sequence<5>{}), ...);
+}
+
+/**
+ * Keccak-f[1600] round function, applying all five step mapping functions on two independent states `in0` and `in1`, writing the results to `out0` and
+ * `out1`. Each step is interleaved across the states, s.t. an out-of-order core always finds independent work from the other state, while waiting on a
+ * long dependency chain of one of them, such as column parities of θ or the rotate-then-χ chain. Output states are produced row by row, which keeps only a
+ * handful of temporaries live, as two states don't fit in the register file anyway.
+ *
+ * See section 3.3 of https://dx.doi.org/10.6028/NIST.FIPS.202.
+ */
+static forceinline constexpr void
+round(std::array<uint64_t, LANE_CNT>& out0,
+      std::array<uint64_t, LANE_CNT>& out1,
+      const std::array<uint64_t, LANE_CNT>& in0,
+      const std::array<uint64_t, LANE_CNT>& in1,
+      const size_t ridx)
+{
+  std::array<uint64_t, 5> c0{};
+  std::array<uint64_t, 5> c1{};
+  std::array<uint64_t, 5> d0{};
+  std::array<uint64_t, 5> d1{};
+
+  // θ step mapping
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 5
+#endif
+  for (size_t x = 0; x < 5; x++) {
+    c0[x] = in0[x] ^ in0[x + 5] ^ in0[x + 10] ^ in0[x + 15] ^ in0[x + 20];
+    c1[x] = in1[x] ^ in1[x + 5] ^ in1[x + 10] ^ in1[x + 15] ^ in1[x + 20];
+  }
+
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 5
+#endif
+  for (size_t x = 0; x < 5; x++) {
+    d0[x] = c0[(x + 4) % 5] ^ std::rotl(c0[(x + 1) % 5], 1);
+    d1[x] = c1[(x + 4) % 5] ^ std::rotl(c1[(x + 1) % 5], 1);
+  }
+
+  // ρ, π and χ step mapping
+  rho_pi_chi(out0, out1, in0, in1, d0, d1, std::make_index_sequence<5>{});
+
+  // ι step mapping
+  out0[0] ^= RC[ridx];
+  out1[0] ^= RC[ridx];
+}
+
+}
+
+/**
+ * Portable 2-way Keccak-p[1600] permutation, on two lane-major interleaved states i.e. lane `i` of state `j` lives at index `i * 2 + j` of `states`.
+ *
+ * It needs no SIMD, as rounds of both states are interleaved in scalar registers, see `x2::round`. It is meant for targets where no SIMD backend is
+ * available, and whose cores are bound by latency of a single state's dependency chains, rather than by issue width. Whether it beats permuting both states
+ * one after another depends on the core and on the size of its register file, so measure it using the "keccak-p[1600, 24] scalar batch=..." benchmarks.
+ * On x86-64 hosts, with only sixteen general purpose registers, it has been measured to be slower.
+ */
+template<size_t num_rounds>
+forceinline constexpr void
+permute_x2_portable(std::span<uint64_t, LANE_CNT * X2_STATE_CNT> states)
+{
+  std::array<uint64_t, LANE_CNT> s0{};
+  std::array<uint64_t, LANE_CNT> s1{};
+
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    s0[i] = states[(i * X2_STATE_CNT) + 0];
+    s1[i] = states[(i * X2_STATE_CNT) + 1];
+  }
+
+  std::array<uint64_t, LANE_CNT> t0{};
+  std::array<uint64_t, LANE_CNT> t1{};
+
+  // Rounds are applied in pairs, going back and forth between the states and temporary ones.
+#if defined __clang__
+#pragma clang loop unroll(disable)
+#elif defined __GNUG__
+#pragma GCC unroll 1
+#endif
+  for (size_t i = MAX_NUM_ROUNDS - num_rounds; i < MAX_NUM_ROUNDS; i += 2) {
+    x2::round(t0, t1, s0, s1, i);
+    x2::round(s0, s1, t0, t1, i + 1);
+  }
+
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    states[(i * X2_STATE_CNT) + 0] = s0[i];
+    states[(i * X2_STATE_CNT) + 1] = s1[i];
+  }
+}
+
+#if defined(SHA3_HAS_AARCH64_SHA3_BACKEND)
+namespace neon_sha3 {
+
+// Applies last `num_rounds` rounds of Keccak-f[1600] permutation on two lane-major interleaved states, s.t. each 128 -bit register holds the same lane of
+// both states, which is exactly how they are laid out in memory.
+template<size_t num_rounds>
+SHA3_TARGET_SHA3 static inline void
+permute_x2(std::span<uint64_t, LANE_CNT * X2_STATE_CNT> states)
+{
+  std::array<uint64x2_t, LANE_CNT> lanes{};
+
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    lanes[i] = vld1q_u64(states.subspan(i * X2_STATE_CNT, X2_STATE_CNT).data());
+  }
+
+  for (size_t i = MAX_NUM_ROUNDS - num_rounds; i < MAX_NUM_ROUNDS; i++) {
+    round_x2(lanes, RC[i]);
+  }
+
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    vst1q_u64(states.subspan(i * X2_STATE_CNT, X2_STATE_CNT).data(), lanes[i]);
+  }
+}
+
+}
+#endif
+
+/**
+ * Applies Keccak-p[1600, 12] or Keccak-p[1600, 24] permutation (as requested by template argument) on two independent states, stored in lane-major
+ * interleaved form i.e. lane `i` of state `j` lives at index `i * 2 + j` of `states`. Output is bit-identical to calling `permute` on each state.
+ *
+ * Uses the ARMv8.2 SHA3 extension when the CPU supports it, otherwise falls back to `permute_x2_portable`.
+ */
+template<size_t num_rounds>
+forceinline constexpr void
+permute_x2(std::span<uint64_t, LANE_CNT * X2_STATE_CNT> states)
+  requires((num_rounds == 12) || (num_rounds == MAX_NUM_ROUNDS))
+{
+  if (!std::is_constant_evaluated()) {
+#if defined(SHA3_HAS_AARCH64_SHA3_BACKEND)
+    if (cpu_features::has_sha3()) {
+      neon_sha3::permute_x2<num_rounds>(states);
+      return;
+    }
+#endif
+  }
+
+  permute_x2_portable<num_rounds>(states);
+}
+
+}
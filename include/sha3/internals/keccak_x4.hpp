@@ -0,0 +1,178 @@
+#pragma once
+#include "sha3/internals/cpu_features.hpp"
+#include "sha3/internals/force_inline.hpp"
+#include "sha3/internals/keccak.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+#include <immintrin.h>
+#endif
+
+// 4-way multi-buffer Keccak-p[1600, 12] and Keccak-p[1600, 24] permutation
+namespace keccak {
+
+// # -of independent Keccak-f[1600] states, permuted together by `permute_x4`.
+static constexpr size_t X4_STATE_CNT = 4;
+
+/**
+ * Portable 4-way Keccak-p[1600] permutation, which permutes each of the four lane-major interleaved states, one after another, using `permute`.
+ * Lane `i` of state `j` lives at index `i * 4 + j` of `states`.
+ *
+ * This is the fallback for targets where no SIMD backend is available and it also serves compile-time evaluation.
+ */
+template<size_t num_rounds>
+forceinline constexpr void
+permute_x4_portable(std::span<uint64_t, LANE_CNT * X4_STATE_CNT> states)
+{
+  std::array<uint64_t, LANE_CNT> state{};
+
+  for (size_t j = 0; j < X4_STATE_CNT; j++) {
+    for (size_t i = 0; i < LANE_CNT; i++) {
+      state[i] = states[(i * X4_STATE_CNT) + j];
+    }
+
+    permute<num_rounds>(state);
+
+    for (size_t i = 0; i < LANE_CNT; i++) {
+      states[(i * X4_STATE_CNT) + j] = state[i];
+    }
+  }
+}
+
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+
+// Only `may_alias` attribute of `__m256i` is dropped when used as element type of `std::array`, which is harmless here.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wignored-attributes"
+
+// AVX2 backend of Keccak-p[1600] permutation, where each 256 -bit register holds the same lane of four independent states.
+namespace avx2 {
+
+// Leftwards circular rotation of each 64 -bit lane by `n` -bits. Rotation by 8 or 56 bits is a byte shuffle, which is cheaper than two shifts and an OR.
+SHA3_TARGET_AVX2 static forceinline __m256i
+rotl(const __m256i x, const int n)
+{
+  if (n == 0) {
+    return x;
+  }
+  if (n == 8) {
+    return _mm256_shuffle_epi8(x, _mm256_setr_epi8(7, 0, 1, 2, 3, 4, 5, 6, 15, 8, 9, 10, 11, 12, 13, 14, 7, 0, 1, 2, 3, 4, 5, 6, 15, 8, 9, 10, 11, 12, 13, 14));
+  }
+  if (n == 56) {
+    return _mm256_shuffle_epi8(x, _mm256_setr_epi8(1, 2, 3, 4, 5, 6, 7, 0, 9, 10, 11, 12, 13, 14, 15, 8, 1, 2, 3, 4, 5, 6, 7, 0, 9, 10, 11, 12, 13, 14, 15, 8));
+  }
+
+  return _mm256_or_si256(_mm256_slli_epi64(x, n), _mm256_srli_epi64(x, 64 - n));
+}
+
+/**
+ * Keccak-f[1600] round function, applying all five step mapping functions on four states at once. `round_constant` is the one for the round being applied.
+ *
+ * See section 3.3 of https://dx.doi.org/10.6028/NIST.FIPS.202.
+ */
+SHA3_TARGET_AVX2 static forceinline void
+round_x4(std::array<__m256i, LANE_CNT>& state, const uint64_t round_constant)
+{
+  std::array<__m256i, 5> bc{};
+  std::array<__m256i, 5> d{};
+  std::array<__m256i, LANE_CNT> b{};
+
+  // θ step mapping
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 5
+#endif
+  for (size_t x = 0; x < 5; x++) {
+    bc[x] = _mm256_xor_si256(_mm256_xor_si256(state[x], state[x + 5]), _mm256_xor_si256(state[x + 10], state[x + 15]));
+    bc[x] = _mm256_xor_si256(bc[x], state[x + 20]);
+  }
+
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 5
+#endif
+  for (size_t x = 0; x < 5; x++) {
+    d[x] = _mm256_xor_si256(bc[(x + 4) % 5], rotl(bc[(x + 1) % 5], 1));
+  }
+
+  // ρ and π step mapping functions, fused
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 25
+#endif
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    b[i] = rotl(_mm256_xor_si256(state[PERM[i]], d[PERM[i] % 5]), ROT[PERM[i]]);
+  }
+
+  // χ step mapping
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 25
+#endif
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    const size_t row = i - (i % 5);
+    state[i] = _mm256_xor_si256(b[i], _mm256_andnot_si256(b[row + ((i + 1) % 5)], b[row + ((i + 2) % 5)]));
+  }
+
+  // ι step mapping
+  state[0] = _mm256_xor_si256(state[0], _mm256_set1_epi64x(static_cast<long long>(round_constant)));
+}
+
+// Applies last `num_rounds` rounds of Keccak-f[1600] permutation on four lane-major interleaved states.
+template<size_t num_rounds>
+SHA3_TARGET_AVX2 static inline void
+permute_x4(std::span<uint64_t, LANE_CNT * X4_STATE_CNT> states)
+{
+  std::array<__m256i, LANE_CNT> lanes{};
+
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    lanes[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(states.subspan(i * X4_STATE_CNT, X4_STATE_CNT).data())); // NOLINT
+  }
+
+  for (size_t i = MAX_NUM_ROUNDS - num_rounds; i < MAX_NUM_ROUNDS; i++) {
+    round_x4(lanes, RC[i]);
+  }
+
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(states.subspan(i * X4_STATE_CNT, X4_STATE_CNT).data()), lanes[i]); // NOLINT
+  }
+}
+
+}
+
+#pragma GCC diagnostic pop
+
+#endif
+
+/**
+ * Applies Keccak-p[1600, 12] or Keccak-p[1600, 24] permutation (as requested by template argument) on four independent states, stored in lane-major
+ * interleaved form i.e. lane `i` of state `j` lives at index `i * 4 + j` of `states`. Output is bit-identical to calling `permute` on each state.
+ *
+ * Uses AVX2 when the CPU supports it, otherwise falls back to permuting the states one after another.
+ */
+template<size_t num_rounds>
+forceinline constexpr void
+permute_x4(std::span<uint64_t, LANE_CNT * X4_STATE_CNT> states)
+  requires((num_rounds == 12) || (num_rounds == MAX_NUM_ROUNDS))
+{
+  if (!std::is_constant_evaluated()) {
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+    if (cpu_features::has_avx2()) {
+      avx2::permute_x4<num_rounds>(states);
+      return;
+    }
+#endif
+  }
+
+  permute_x4_portable<num_rounds>(states);
+}
+
+}
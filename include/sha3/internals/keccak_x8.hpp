@@ -0,0 +1,175 @@
+#pragma once
+#include "sha3/internals/cpu_features.hpp"
+#include "sha3/internals/force_inline.hpp"
+#include "sha3/internals/keccak.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+#include <immintrin.h>
+#endif
+
+// 8-way multi-buffer Keccak-p[1600, 12] and Keccak-p[1600, 24] permutation
+namespace keccak {
+
+// # -of independent Keccak-f[1600] states, permuted together by `permute_x8`.
+static constexpr size_t X8_STATE_CNT = 8;
+
+/**
+ * Portable 8-way Keccak-p[1600] permutation, which permutes each of the eight lane-major interleaved states, one after another, using `permute`.
+ * Lane `i` of state `j` lives at index `i * 8 + j` of `states`.
+ */
+template<size_t num_rounds>
+forceinline constexpr void
+permute_x8_portable(std::span<uint64_t, LANE_CNT * X8_STATE_CNT> states)
+{
+  std::array<uint64_t, LANE_CNT> state{};
+
+  for (size_t j = 0; j < X8_STATE_CNT; j++) {
+    for (size_t i = 0; i < LANE_CNT; i++) {
+      state[i] = states[(i * X8_STATE_CNT) + j];
+    }
+
+    permute<num_rounds>(state);
+
+    for (size_t i = 0; i < LANE_CNT; i++) {
+      states[(i * X8_STATE_CNT) + j] = state[i];
+    }
+  }
+}
+
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+
+// Only `may_alias` attribute of `__m512i` is dropped when used as element type of `std::array`, which is harmless here. And GCC falsely reports
+// self-initialized `_mm512_undefined_epi32()`, used inside AVX-512 intrinsics, as (maybe) uninitialized, when those get inlined into callers.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wignored-attributes"
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#if !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+// AVX-512 backend of Keccak-p[1600] permutation, where each 512 -bit register holds the same lane of eight independent states.
+namespace avx512 {
+
+// Leftwards circular rotation of each 64 -bit lane by `n` -bits, using `vprolq`, which takes rotation offset as an immediate operand.
+template<int n>
+SHA3_TARGET_AVX512 static forceinline __m512i
+rotl(const __m512i x)
+{
+  return _mm512_rol_epi64(x, n);
+}
+
+// Fused ρ and π step mapping functions. Rotation offsets must be compile-time constants.
+template<size_t... i>
+SHA3_TARGET_AVX512 static forceinline void
+rho_pi(std::array<__m512i, LANE_CNT>& b, const std::array<__m512i, LANE_CNT>& state, const std::array<__m512i, 5>& d, std::index_sequence<i...> /* unused */)
+{
+  ((b[i] = rotl<ROT[PERM[i]]>(_mm512_xor_si512(state[PERM[i]], d[PERM[i] % 5]))), ...);
+}
+
+/**
+ * Keccak-f[1600] round function, applying all five step mapping functions on eight states at once. `round_constant` is the one for the round being applied.
+ * Both θ and χ are computed using three-input `vpternlogq`, while ρ uses `vprolq`.
+ *
+ * See section 3.3 of https://dx.doi.org/10.6028/NIST.FIPS.202.
+ */
+SHA3_TARGET_AVX512 static forceinline void
+round_x8(std::array<__m512i, LANE_CNT>& state, const uint64_t round_constant)
+{
+  std::array<__m512i, 5> bc{};
+  std::array<__m512i, 5> d{};
+  std::array<__m512i, LANE_CNT> b{};
+
+  // θ step mapping
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 5
+#endif
+  for (size_t x = 0; x < 5; x++) {
+    bc[x] = _mm512_ternarylogic_epi64(state[x], state[x + 5], state[x + 10], TERNLOG_XOR3);
+    bc[x] = _mm512_ternarylogic_epi64(bc[x], state[x + 15], state[x + 20], TERNLOG_XOR3);
+  }
+
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 5
+#endif
+  for (size_t x = 0; x < 5; x++) {
+    d[x] = _mm512_xor_si512(bc[(x + 4) % 5], rotl<1>(bc[(x + 1) % 5]));
+  }
+
+  // ρ and π step mapping functions, fused
+  rho_pi(b, state, d, std::make_index_sequence<LANE_CNT>{});
+
+  // χ step mapping
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 25
+#endif
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    const size_t row = i - (i % 5);
+    state[i] = _mm512_ternarylogic_epi64(b[i], b[row + ((i + 1) % 5)], b[row + ((i + 2) % 5)], TERNLOG_CHI);
+  }
+
+  // ι step mapping
+  state[0] = _mm512_xor_si512(state[0], _mm512_set1_epi64(static_cast<long long>(round_constant)));
+}
+
+// Applies last `num_rounds` rounds of Keccak-f[1600] permutation on eight lane-major interleaved states.
+template<size_t num_rounds>
+SHA3_TARGET_AVX512 static inline void
+permute_x8(std::span<uint64_t, LANE_CNT * X8_STATE_CNT> states)
+{
+  std::array<__m512i, LANE_CNT> lanes{};
+
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    lanes[i] = _mm512_loadu_si512(states.subspan(i * X8_STATE_CNT, X8_STATE_CNT).data());
+  }
+
+  for (size_t i = MAX_NUM_ROUNDS - num_rounds; i < MAX_NUM_ROUNDS; i++) {
+    round_x8(lanes, RC[i]);
+  }
+
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    _mm512_storeu_si512(states.subspan(i * X8_STATE_CNT, X8_STATE_CNT).data(), lanes[i]);
+  }
+}
+
+}
+
+#pragma GCC diagnostic pop
+
+#endif
+
+/**
+ * Applies Keccak-p[1600, 12] or Keccak-p[1600, 24] permutation (as requested by template argument) on eight independent states, stored in lane-major
+ * interleaved form i.e. lane `i` of state `j` lives at index `i * 8 + j` of `states`. Output is bit-identical to calling `permute` on each state.
+ *
+ * Uses AVX-512 when the CPU supports it, otherwise falls back to permuting the states one after another, so that the same binary runs on every host.
+ */
+template<size_t num_rounds>
+forceinline constexpr void
+permute_x8(std::span<uint64_t, LANE_CNT * X8_STATE_CNT> states)
+  requires((num_rounds == 12) || (num_rounds == MAX_NUM_ROUNDS))
+{
+  if (!std::is_constant_evaluated()) {
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+    if (cpu_features::has_avx512f()) {
+      avx512::permute_x8<num_rounds>(states);
+      return;
+    }
+#endif
+  }
+
+  permute_x8_portable<num_rounds>(states);
+}
+
+}
@@ -0,0 +1,204 @@
+#pragma once
+#include "sha3/internals/cpu_features.hpp"
+#include "sha3/internals/cshake.hpp"
+#include "sha3/internals/keccak.hpp"
+#include "sha3/internals/keccak_x4.hpp"
+#include "sha3/internals/keccak_x8.hpp"
+#include "sha3/internals/sponge.hpp"
+#include "sha3/internals/sponge_many.hpp"
+#include "sha3/internals/state_batch.hpp"
+#include "sha3/internals/thread_pool.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+// ParallelHash, on top of cSHAKE, as specified in section 6 of NIST SP 800-185 https://doi.org/10.6028/NIST.SP.800-185
+namespace parallelhash {
+
+// Function name N, final node of ParallelHash is customized with.
+static constexpr std::array<uint8_t, 12> FUNCTION_NAME{ 'P', 'a', 'r', 'a', 'l', 'l', 'e', 'l', 'H', 'a', 's', 'h' };
+
+// Minimum # -of input bytes hashed by a single task, when blocks are spread across threads, same as a task of KangarooTwelve leaves.
+static constexpr size_t MIN_TASK_BYTE_LEN = 128 * 1024;
+
+// # -of tasks per thread, whose chaining values are buffered, before being absorbed into the final node, bounding memory use for long inputs.
+static constexpr size_t TASKS_PER_THREAD = 4;
+
+/**
+ * Returns # -of `block_len` -byte blocks, hashed by a single task, which is at least `MIN_TASK_BYTE_LEN` -bytes of input and a multiple of the widest
+ * multi-buffer permutation.
+ */
+static constexpr size_t
+blocks_per_task(const size_t block_len)
+{
+  const size_t block_cnt = (MIN_TASK_BYTE_LEN + block_len - 1) / block_len;
+  return ((block_cnt + keccak::X8_STATE_CNT - 1) / keccak::X8_STATE_CNT) * keccak::X8_STATE_CNT;
+}
+
+/**
+ * Hashes `lane_cnt` blocks, laid out one after another in `blocks`, each of `block_len` -bytes, together, using cSHAKE with empty function name and
+ * customization string, which is SHAKE, in lanes of multi-buffer Keccak-p[1600] permutation, writing their `cv_len` -byte chaining values to `cvs`, in same
+ * order. Every block has same length, so all of them stay in lockstep, from first rate-sized block to squeezing.
+ */
+template<size_t num_bits_in_rate, size_t cv_len, size_t lane_cnt>
+static inline void
+hash_block_group(std::span<const uint8_t> blocks, const size_t block_len, std::span<uint8_t> cvs)
+{
+  constexpr size_t num_bytes_in_rate = num_bits_in_rate / std::numeric_limits<uint8_t>::digits;
+  static_assert(cv_len <= num_bytes_in_rate, "Chaining value must be squeezable out of a single permutation state.");
+
+  const size_t full_blocks_byte_len = block_len - (block_len % num_bytes_in_rate);
+  const size_t tail_byte_len = block_len - full_blocks_byte_len;
+
+  keccak::state_batch<lane_cnt> states{};
+
+  for (size_t block_offset = 0; block_offset < full_blocks_byte_len; block_offset += num_bytes_in_rate) {
+    for (size_t j = 0; j < lane_cnt; j++) {
+      states.template absorb_block<num_bits_in_rate>(j, blocks.subspan((j * block_len) + block_offset).template first<num_bytes_in_rate>());
+    }
+
+    states.template permute<cshake::NUM_KECCAK_ROUNDS>();
+  }
+
+  std::array<uint64_t, keccak::LANE_CNT> state{};
+
+  for (size_t j = 0; j < lane_cnt; j++) {
+    states.absorb_bytes(j, 0, blocks.subspan((j * block_len) + full_blocks_byte_len, tail_byte_len));
+
+    states.load(j, state);
+    sponge::pad<cshake::SHAKE_DOM_SEP, cshake::SHAKE_DOM_SEP_BW, num_bits_in_rate>(state, tail_byte_len);
+    states.store(j, state);
+  }
+
+  states.template permute<cshake::NUM_KECCAK_ROUNDS>();
+
+  for (size_t j = 0; j < lane_cnt; j++) {
+    states.squeeze_bytes(j, 0, cvs.subspan(j * cv_len, cv_len));
+  }
+}
+
+/**
+ * Hashes blocks, laid out one after another in `blocks`, each of `block_len` -bytes, writing their `cv_len` -byte chaining values to `cvs`, in same order.
+ * Blocks are hashed eight at a time, when the CPU supports AVX-512, then four at a time, and the last few, on the scalar path.
+ */
+template<size_t num_bits_in_rate, size_t cv_len>
+static inline void
+hash_blocks(std::span<const uint8_t> blocks, const size_t block_len, std::span<uint8_t> cvs)
+{
+  const size_t block_cnt = blocks.size() / block_len;
+  size_t block = 0;
+
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+  if (cpu_features::has_avx512f()) {
+    for (; (block_cnt - block) >= keccak::X8_STATE_CNT; block += keccak::X8_STATE_CNT) {
+      hash_block_group<num_bits_in_rate, cv_len, keccak::X8_STATE_CNT>(
+        blocks.subspan(block * block_len, keccak::X8_STATE_CNT * block_len), block_len, cvs.subspan(block * cv_len, keccak::X8_STATE_CNT * cv_len));
+    }
+  }
+#endif
+
+  for (; (block_cnt - block) >= keccak::X4_STATE_CNT; block += keccak::X4_STATE_CNT) {
+    hash_block_group<num_bits_in_rate, cv_len, keccak::X4_STATE_CNT>(
+      blocks.subspan(block * block_len, keccak::X4_STATE_CNT * block_len), block_len, cvs.subspan(block * cv_len, keccak::X4_STATE_CNT * cv_len));
+  }
+
+  for (; block < block_cnt; block++) {
+    sponge::hash_one<cshake::SHAKE_DOM_SEP, cshake::SHAKE_DOM_SEP_BW, num_bits_in_rate, cshake::NUM_KECCAK_ROUNDS>(blocks.subspan(block * block_len, block_len),
+                                                                                                                 cvs.subspan(block * cv_len, cv_len));
+  }
+}
+
+/**
+ * Same as `hash_blocks`, but when `pool` is given and has more than one thread, blocks get split into tasks of `blocks_per_task(block_len)` blocks, which are
+ * spread across threads of the pool.
+ */
+template<size_t num_bits_in_rate, size_t cv_len>
+static inline void
+hash_blocks(std::span<const uint8_t> blocks, const size_t block_len, std::span<uint8_t> cvs, sha3_utils::thread_pool_t* const pool)
+{
+  const size_t block_cnt = blocks.size() / block_len;
+  const size_t task_block_cnt = blocks_per_task(block_len);
+
+  if ((pool == nullptr) || (pool->thread_cnt() == 1) || (block_cnt <= task_block_cnt)) {
+    hash_blocks<num_bits_in_rate, cv_len>(blocks, block_len, cvs);
+    return;
+  }
+
+  const size_t task_cnt = (block_cnt + task_block_cnt - 1) / task_block_cnt;
+
+  pool->parallel_for(task_cnt, [&](const size_t task) {
+    const size_t first_block = task * task_block_cnt;
+    const size_t cnt = std::min(task_block_cnt, block_cnt - first_block);
+
+    hash_blocks<num_bits_in_rate, cv_len>(blocks.subspan(first_block * block_len, cnt * block_len), block_len, cvs.subspan(first_block * cv_len, cnt * cv_len));
+  });
+}
+
+/**
+ * One-shot ParallelHash, writing `out.size()` -bytes of output for message `msg`, split into blocks of `block_len` -bytes, and customization string
+ * `customization`, on top of cSHAKE with rate of `num_bits_in_rate`, producing `cv_len` -byte chaining values. When `xof` is set, it is ParallelHashXOF,
+ * whose output is a prefix of any longer output, otherwise requested output bit length is bound into the output.
+ *
+ * Full blocks are hashed straight out of `msg`, in lanes of multi-buffer permutation, and, when `pool` is given, across its threads, while only the last
+ * block, if shorter than `block_len`, is hashed on the scalar path. Chaining values are absorbed into the final node in rounds of `TASKS_PER_THREAD` tasks
+ * per thread, so memory use stays bounded, no matter how long the message is. SP 800-185 requires `block_len` > 0, so nothing is written, otherwise.
+ */
+template<size_t num_bits_in_rate, size_t cv_len>
+static inline void
+hash(std::span<const uint8_t> msg,
+     const size_t block_len,
+     std::span<const uint8_t> customization,
+     std::span<uint8_t> out,
+     const bool xof,
+     sha3_utils::thread_pool_t* const pool)
+{
+  if (block_len == 0) {
+    return;
+  }
+
+  const size_t full_block_cnt = msg.size() / block_len;
+  const size_t block_cnt = (msg.size() + block_len - 1) / block_len;
+
+  std::array<uint8_t, cshake::ENCODE_MAX_BYTE_LEN> encoded{};
+  size_t encoded_len = cshake::left_encode(block_len, encoded);
+
+  cshake::cshake_t<num_bits_in_rate> final_node(FUNCTION_NAME, customization);
+  final_node.absorb(std::span<const uint8_t>(encoded).first(encoded_len));
+
+  const size_t thread_cnt = (pool == nullptr) ? 1 : pool->thread_cnt();
+  const size_t round_block_cnt = std::min(full_block_cnt, blocks_per_task(block_len) * TASKS_PER_THREAD * thread_cnt);
+
+  std::vector<uint8_t> cvs(std::max<size_t>(round_block_cnt, 1) * cv_len);
+  auto cvs_span = std::span(cvs);
+
+  for (size_t block = 0; block < full_block_cnt; block += round_block_cnt) {
+    const size_t cnt = std::min(round_block_cnt, full_block_cnt - block);
+    const auto round_cvs = cvs_span.first(cnt * cv_len);
+
+    hash_blocks<num_bits_in_rate, cv_len>(msg.subspan(block * block_len, cnt * block_len), block_len, round_cvs, pool);
+    final_node.absorb(round_cvs);
+  }
+
+  if (full_block_cnt < block_cnt) {
+    const auto last_cv = cvs_span.first(cv_len);
+
+    sponge::hash_one<cshake::SHAKE_DOM_SEP, cshake::SHAKE_DOM_SEP_BW, num_bits_in_rate, cshake::NUM_KECCAK_ROUNDS>(msg.subspan(full_block_cnt * block_len),
+                                                                                                                 last_cv);
+    final_node.absorb(last_cv);
+  }
+
+  encoded_len = cshake::right_encode(block_cnt, encoded);
+  final_node.absorb(std::span<const uint8_t>(encoded).first(encoded_len));
+
+  encoded_len = cshake::right_encode(xof ? 0 : out.size() * std::numeric_limits<uint8_t>::digits, encoded);
+  final_node.absorb(std::span<const uint8_t>(encoded).first(encoded_len));
+
+  final_node.finalize();
+  final_node.squeeze(out);
+}
+
+}
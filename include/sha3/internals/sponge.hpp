@@ -1,4 +1,6 @@
 #pragma once
+#include "sha3/internals/backend.hpp"
+#include "sha3/internals/cpu_features.hpp"
 #include "sha3/internals/force_inline.hpp"
 #include "sha3/internals/keccak.hpp"
 #include "sha3/internals/utils.hpp"
@@ -8,6 +10,7 @@
 #include <cstring>
 #include <limits>
 #include <span>
+#include <type_traits>
 
 // Keccak family of sponge functions
 namespace sponge {
@@ -21,6 +24,42 @@ check_domain_separator(const size_t dom_sep_bit_len)
   return dom_sep_bit_len <= 6U;
 }
 
+/**
+ * Fused absorb loop, for full rate-sized blocks, same as `FastLoop_Absorb` of XKCP. Given `blocks`, whose length is a multiple of `rate/ 8` -bytes, this
+ * routine XORs each block into rate portion of the Keccak[c] permutation state, straight from the input buffer, and permutes the state. Lanes are kept in a
+ * local copy of the state, for the whole loop, s.t. the compiler is free to keep them in registers, and the state is written back only once, at the end.
+ *
+ * - `num_bits_in_rate` portion of sponge will have bitwidth of 1600 - c.
+ * - No message bytes must be pending in rate portion of the state i.e. `offset` must be 0, before calling this routine, and it stays so.
+ */
+template<size_t num_bits_in_rate, size_t num_rounds, keccak::backend_t backend = keccak::backend_t::scalar>
+static forceinline constexpr void
+absorb_blocks(std::array<uint64_t, keccak::LANE_CNT>& state, std::span<const uint8_t> blocks)
+{
+  constexpr size_t num_bytes_in_rate = num_bits_in_rate / std::numeric_limits<uint8_t>::digits;
+  constexpr size_t num_words_in_rate = num_bytes_in_rate / KECCAK_WORD_BYTE_LEN;
+
+  auto lanes = state;
+
+  for (size_t block_offset = 0; block_offset < blocks.size(); block_offset += num_bytes_in_rate) {
+    const auto block = std::span<const uint8_t, num_bytes_in_rate>(blocks.subspan(block_offset, num_bytes_in_rate));
+
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 21
+#endif
+    for (size_t i = 0; i < num_words_in_rate; i++) {
+      auto msg_chunk = std::span<const uint8_t, KECCAK_WORD_BYTE_LEN>(block.subspan(i * KECCAK_WORD_BYTE_LEN, KECCAK_WORD_BYTE_LEN));
+      lanes[i] ^= sha3_utils::le_bytes_to_u64(msg_chunk);
+    }
+
+    keccak::permute_using<backend, num_rounds>(lanes);
+  }
+
+  state = lanes;
+}
+
 /**
  * Given `mlen` (>=0) -bytes message, this routine consumes it into Keccak[c] permutation state s.t. `offset` ( second parameter ) denotes how many bytes are
  * already consumed into rate portion of the state.
@@ -28,60 +67,75 @@ check_domain_separator(const size_t dom_sep_bit_len)
  * - `num_bits_in_rate` portion of sponge will have bitwidth of 1600 - c.
  * - `offset` must ∈ [0, `num_bytes_in_rate`).
  *
+ * Whenever `offset` is 0 and at least `rate/ 8` -bytes of message are remaining, full blocks are absorbed using `absorb_blocks`. Otherwise message words
+ * are loaded straight from `msg`, and only the partial words, at the head and the tail of a block, are staged.
+ *
+ * Keccak-p[1600] permutation is applied using the requested `backend`, see `keccak::permute_using`. Prefer `absorb`, which picks the backend bound to the CPU.
+ *
  * This function implementation collects inspiration from https://github.com/itzmeanjan/turboshake/blob/e1a6b950/src/sponge.rs#L4-L56.
  */
-template<size_t num_bits_in_rate, size_t num_rounds>
+template<size_t num_bits_in_rate, size_t num_rounds, keccak::backend_t backend = keccak::backend_t::scalar>
 static forceinline constexpr void
-absorb(std::array<uint64_t, keccak::LANE_CNT>& state, size_t& offset, std::span<const uint8_t> msg)
+absorb_using(std::array<uint64_t, keccak::LANE_CNT>& state, size_t& offset, std::span<const uint8_t> msg)
 {
   constexpr size_t num_bytes_in_rate = num_bits_in_rate / std::numeric_limits<uint8_t>::digits;
 
-  std::array<uint8_t, num_bytes_in_rate> block{};
-  auto block_span = std::span(block);
-
   size_t msg_offset = 0;
   while (msg_offset < msg.size()) {
     const size_t remaining_num_bytes = msg.size() - msg_offset;
+
+    // Full blocks are absorbed by the fused loop, once no message bytes are pending in the state.
+    if ((offset == 0) && (remaining_num_bytes >= num_bytes_in_rate)) {
+      const size_t full_blocks_byte_len = remaining_num_bytes - (remaining_num_bytes % num_bytes_in_rate);
+
+      absorb_blocks<num_bits_in_rate, num_rounds, backend>(state, msg.subspan(msg_offset, full_blocks_byte_len));
+      msg_offset += full_blocks_byte_len;
+      continue;
+    }
+
     const size_t absorbable_num_bytes = std::min(remaining_num_bytes, num_bytes_in_rate - offset);
-    const size_t effective_block_byte_len = offset + absorbable_num_bytes;
-    const size_t padded_effective_block_byte_len = (effective_block_byte_len + (KECCAK_WORD_BYTE_LEN - 1)) & (-KECCAK_WORD_BYTE_LEN);
-    const size_t padded_effective_block_begins_at = offset & (-KECCAK_WORD_BYTE_LEN);
+    const auto absorbable = msg.subspan(msg_offset, absorbable_num_bytes);
 
-    std::fill_n(block_span.subspan(padded_effective_block_begins_at).begin(), padded_effective_block_byte_len - padded_effective_block_begins_at, 0x00);
-    std::copy_n(msg.subspan(msg_offset).begin(), absorbable_num_bytes, block_span.subspan(offset).begin());
+    // Words, fully covered by the message, are loaded straight from it, while only the partial ones, at either end, are staged in a zero-filled word.
+    size_t absorbed_num_bytes = 0;
+    while (absorbed_num_bytes < absorbable_num_bytes) {
+      const size_t state_byte_offset = offset + absorbed_num_bytes;
+      const size_t state_word_index = state_byte_offset / KECCAK_WORD_BYTE_LEN;
+      const size_t byte_index_in_state_word = state_byte_offset % KECCAK_WORD_BYTE_LEN;
+      const size_t chunk_byte_len = std::min(KECCAK_WORD_BYTE_LEN - byte_index_in_state_word, absorbable_num_bytes - absorbed_num_bytes);
 
-    size_t state_word_index = padded_effective_block_begins_at / KECCAK_WORD_BYTE_LEN;
-    for (size_t i = padded_effective_block_begins_at; i < padded_effective_block_byte_len; i += KECCAK_WORD_BYTE_LEN) {
-      auto msg_chunk = std::span<const uint8_t, KECCAK_WORD_BYTE_LEN>(block_span.subspan(i, KECCAK_WORD_BYTE_LEN));
-      auto msg_word = sha3_utils::le_bytes_to_u64(msg_chunk);
+      if (chunk_byte_len == KECCAK_WORD_BYTE_LEN) {
+        auto msg_chunk = std::span<const uint8_t, KECCAK_WORD_BYTE_LEN>(absorbable.subspan(absorbed_num_bytes, KECCAK_WORD_BYTE_LEN));
+        state[state_word_index] ^= sha3_utils::le_bytes_to_u64(msg_chunk);
+      } else {
+        std::array<uint8_t, KECCAK_WORD_BYTE_LEN> word{};
+        std::copy_n(absorbable.subspan(absorbed_num_bytes).begin(), chunk_byte_len, std::span(word).subspan(byte_index_in_state_word).begin());
+        state[state_word_index] ^= sha3_utils::le_bytes_to_u64(word);
+      }
 
-      state[state_word_index] ^= msg_word;
-      state_word_index++;
+      absorbed_num_bytes += chunk_byte_len;
     }
 
     offset += absorbable_num_bytes;
     msg_offset += absorbable_num_bytes;
 
     if (offset == num_bytes_in_rate) [[unlikely]] {
-      keccak::permute<num_rounds>(state);
+      keccak::permute_using<backend, num_rounds>(state);
       offset = 0;
     }
   }
 }
 
 /**
- * Given that N message bytes are already consumed into Keccak[c] permutation state, this routine finalizes sponge state and makes it ready for squeezing, by
- * appending (along with domain separation bits) `10*1` padding bits to input message s.t. total absorbed message byte length becomes multiple of `rate/ 8`
- * -bytes.
+ * Given that `offset` message bytes are pending in rate portion of the Keccak[c] permutation state, this routine XORs domain separation bits and `10*1`
+ * padding bits into the state, without permuting it.
  *
  * - `num_bits_in_rate` portion of sponge will have bitwidth of 1600 - c.
  * - `offset` must ∈ [0, `num_bytes_in_rate`)
- *
- * This function implementation collects some motivation from https://github.com/itzmeanjan/turboshake/blob/e1a6b950/src/sponge.rs#L58-L81.
  */
-template<uint8_t domain_separator, size_t ds_bit_len, size_t num_bits_in_rate, size_t num_rounds>
+template<uint8_t domain_separator, size_t ds_bit_len, size_t num_bits_in_rate>
 static forceinline constexpr void
-finalize(std::array<uint64_t, keccak::LANE_CNT>& state, size_t& offset)
+pad(std::array<uint64_t, keccak::LANE_CNT>& state, const size_t offset)
   requires(check_domain_separator(ds_bit_len))
 {
   constexpr size_t num_bytes_in_rate = num_bits_in_rate / std::numeric_limits<uint8_t>::digits;
@@ -96,11 +150,66 @@ finalize(std::array<uint64_t, keccak::LANE_CNT>& state, size_t& offset)
 
   state[state_word_index] ^= static_cast<uint64_t>(pad_byte) << shl_bit_offset;
   state[num_words_in_rate - 1] ^= UINT64_C(0x80) << 56;
+}
+
+/**
+ * Given that N message bytes are already consumed into Keccak[c] permutation state, this routine finalizes sponge state and makes it ready for squeezing, by
+ * appending (along with domain separation bits) `10*1` padding bits to input message s.t. total absorbed message byte length becomes multiple of `rate/ 8`
+ * -bytes.
+ *
+ * - `num_bits_in_rate` portion of sponge will have bitwidth of 1600 - c.
+ * - `offset` must ∈ [0, `num_bytes_in_rate`)
+ *
+ * This function implementation collects some motivation from https://github.com/itzmeanjan/turboshake/blob/e1a6b950/src/sponge.rs#L58-L81.
+ */
+template<uint8_t domain_separator, size_t ds_bit_len, size_t num_bits_in_rate, size_t num_rounds>
+static forceinline constexpr void
+finalize(std::array<uint64_t, keccak::LANE_CNT>& state, size_t& offset)
+  requires(check_domain_separator(ds_bit_len))
+{
+  pad<domain_separator, ds_bit_len, num_bits_in_rate>(state, offset);
 
   keccak::permute<num_rounds>(state);
   offset = 0;
 }
 
+/**
+ * Fused squeeze loop, for full rate-sized blocks. Given `blocks`, whose length is a multiple of `rate/ 8` -bytes, this routine serializes rate portion of the
+ * Keccak[c] permutation state straight into each output block and permutes the state. Lanes are kept in a local copy of the state, for the whole loop, and
+ * the state is written back only once, at the end.
+ *
+ * - `num_bits_in_rate` portion of sponge will have bitwidth of 1600 - c.
+ * - No byte must have been squeezed out of rate portion of the current state i.e. `squeezable` must be `rate/ 8`, before calling this routine, and it stays
+ *   so.
+ */
+template<size_t num_bits_in_rate, size_t num_rounds, keccak::backend_t backend = keccak::backend_t::scalar>
+static forceinline constexpr void
+squeeze_blocks(std::array<uint64_t, keccak::LANE_CNT>& state, std::span<uint8_t> blocks)
+{
+  constexpr size_t num_bytes_in_rate = num_bits_in_rate / std::numeric_limits<uint8_t>::digits;
+  constexpr size_t num_words_in_rate = num_bytes_in_rate / KECCAK_WORD_BYTE_LEN;
+
+  auto lanes = state;
+
+  for (size_t block_offset = 0; block_offset < blocks.size(); block_offset += num_bytes_in_rate) {
+    const auto block = std::span<uint8_t, num_bytes_in_rate>(blocks.subspan(block_offset, num_bytes_in_rate));
+
+#if defined __clang__
+#pragma clang loop unroll(full)
+#elif defined __GNUG__
+#pragma GCC unroll 21
+#endif
+    for (size_t i = 0; i < num_words_in_rate; i++) {
+      auto out_chunk = std::span<uint8_t, KECCAK_WORD_BYTE_LEN>(block.subspan(i * KECCAK_WORD_BYTE_LEN, KECCAK_WORD_BYTE_LEN));
+      sha3_utils::u64_to_le_bytes(lanes[i], out_chunk);
+    }
+
+    keccak::permute_using<backend, num_rounds>(lanes);
+  }
+
+  state = lanes;
+}
+
 /**
  * Given that Keccak[c] permutation state is finalized, this routine can be invoked for squeezing `olen` -bytes out of rate portion of the state.
  *
@@ -108,44 +217,334 @@ finalize(std::array<uint64_t, keccak::LANE_CNT>& state, size_t& offset)
  * - `squeezable` denotes how many bytes can be squeezed without permutating the sponge state.
  * - When `squeezable` becomes 0, state needs to be permutated again, after which `num_bytes_in_rate` can again be squeezed from rate portion of the state.
  *
+ * Whenever `squeezable` is `rate/ 8` and at least `rate/ 8` -bytes of output are remaining, full blocks are squeezed using `squeeze_blocks`, s.t. partial
+ * block logic only runs at the head and the tail of the output. Even there, output words are stored straight into `out`, and only the partial words are
+ * staged.
+ *
+ * Keccak-p[1600] permutation is applied using the requested `backend`, see `keccak::permute_using`. Prefer `squeeze`, which picks the backend bound to the CPU.
+ *
  * This function implementation collects motivation from https://github.com/itzmeanjan/turboshake/blob/e1a6b950/src/sponge.rs#L83-L118.
  */
-template<size_t num_bits_in_rate, size_t num_rounds>
+template<size_t num_bits_in_rate, size_t num_rounds, keccak::backend_t backend = keccak::backend_t::scalar>
 static forceinline constexpr void
-squeeze(std::array<uint64_t, keccak::LANE_CNT>& state, size_t& squeezable, std::span<uint8_t> out)
+squeeze_using(std::array<uint64_t, keccak::LANE_CNT>& state, size_t& squeezable, std::span<uint8_t> out)
 {
   constexpr size_t num_bytes_in_rate = num_bits_in_rate / std::numeric_limits<uint8_t>::digits;
 
-  std::array<uint8_t, num_bytes_in_rate> blk_bytes{};
-  auto blk_bytes_span = std::span(blk_bytes);
-
   size_t out_offset = 0;
   while (out_offset < out.size()) {
-    const size_t state_byte_offset = num_bytes_in_rate - squeezable;
     const size_t remaining_num_bytes = out.size() - out_offset;
-    const size_t squeezable_num_bytes = std::min(remaining_num_bytes, squeezable);
-    const size_t effective_block_byte_len = state_byte_offset + squeezable_num_bytes;
-    const size_t padded_effective_block_byte_len = (effective_block_byte_len + (KECCAK_WORD_BYTE_LEN - 1)) & (-KECCAK_WORD_BYTE_LEN);
-    const size_t padded_effective_block_begins_at = state_byte_offset & (-KECCAK_WORD_BYTE_LEN);
 
-    size_t state_word_index = padded_effective_block_begins_at / KECCAK_WORD_BYTE_LEN;
-    for (size_t i = padded_effective_block_begins_at; i < padded_effective_block_byte_len; i += KECCAK_WORD_BYTE_LEN) {
-      auto chunk_bytes = std::span<uint8_t, KECCAK_WORD_BYTE_LEN>(blk_bytes_span.subspan(i, KECCAK_WORD_BYTE_LEN));
-      sha3_utils::u64_to_le_bytes(state[state_word_index], chunk_bytes);
+    // Full blocks are squeezed by the fused loop, once rate portion of the state is untouched.
+    if ((squeezable == num_bytes_in_rate) && (remaining_num_bytes >= num_bytes_in_rate)) {
+      const size_t full_blocks_byte_len = remaining_num_bytes - (remaining_num_bytes % num_bytes_in_rate);
 
-      state_word_index++;
+      squeeze_blocks<num_bits_in_rate, num_rounds, backend>(state, out.subspan(out_offset, full_blocks_byte_len));
+      out_offset += full_blocks_byte_len;
+      continue;
     }
 
-    std::copy_n(blk_bytes_span.subspan(state_byte_offset).begin(), squeezable_num_bytes, out.subspan(out_offset).begin());
+    const size_t squeezable_num_bytes = std::min(remaining_num_bytes, squeezable);
+    const auto squeezed = out.subspan(out_offset, squeezable_num_bytes);
+
+    // Words, fully requested, are stored straight into the output, while only the partial ones, at either end, are staged.
+    size_t squeezed_num_bytes = 0;
+    while (squeezed_num_bytes < squeezable_num_bytes) {
+      const size_t state_byte_offset = (num_bytes_in_rate - squeezable) + squeezed_num_bytes;
+      const size_t state_word_index = state_byte_offset / KECCAK_WORD_BYTE_LEN;
+      const size_t byte_index_in_state_word = state_byte_offset % KECCAK_WORD_BYTE_LEN;
+      const size_t chunk_byte_len = std::min(KECCAK_WORD_BYTE_LEN - byte_index_in_state_word, squeezable_num_bytes - squeezed_num_bytes);
+
+      if (chunk_byte_len == KECCAK_WORD_BYTE_LEN) {
+        auto out_chunk = std::span<uint8_t, KECCAK_WORD_BYTE_LEN>(squeezed.subspan(squeezed_num_bytes, KECCAK_WORD_BYTE_LEN));
+        sha3_utils::u64_to_le_bytes(state[state_word_index], out_chunk);
+      } else {
+        std::array<uint8_t, KECCAK_WORD_BYTE_LEN> word{};
+        sha3_utils::u64_to_le_bytes(state[state_word_index], word);
+        std::copy_n(std::span(word).subspan(byte_index_in_state_word).begin(), chunk_byte_len, squeezed.subspan(squeezed_num_bytes).begin());
+      }
+
+      squeezed_num_bytes += chunk_byte_len;
+    }
 
     squeezable -= squeezable_num_bytes;
     out_offset += squeezable_num_bytes;
 
     if (squeezable == 0) [[unlikely]] {
-      keccak::permute<num_rounds>(state);
+      keccak::permute_using<backend, num_rounds>(state);
       squeezable = num_bytes_in_rate;
     }
   }
 }
 
+// Signature of absorb and squeeze loops of the sponge, as compiled for each backend.
+using absorb_fn_t = void (*)(std::array<uint64_t, keccak::LANE_CNT>&, size_t&, std::span<const uint8_t>);
+using squeeze_fn_t = void (*)(std::array<uint64_t, keccak::LANE_CNT>&, size_t&, std::span<uint8_t>);
+
+namespace scalar {
+
+// Absorb loop of the sponge, using the portable Keccak-p[1600] permutation.
+template<size_t num_bits_in_rate, size_t num_rounds>
+static inline void
+absorb(std::array<uint64_t, keccak::LANE_CNT>& state, size_t& offset, std::span<const uint8_t> msg)
+{
+  absorb_using<num_bits_in_rate, num_rounds, keccak::backend_t::scalar>(state, offset, msg);
+}
+
+// Squeeze loop of the sponge, using the portable Keccak-p[1600] permutation.
+template<size_t num_bits_in_rate, size_t num_rounds>
+static inline void
+squeeze(std::array<uint64_t, keccak::LANE_CNT>& state, size_t& squeezable, std::span<uint8_t> out)
+{
+  squeeze_using<num_bits_in_rate, num_rounds, keccak::backend_t::scalar>(state, squeezable, out);
+}
+
+}
+
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+
+// Absorb and squeeze loops of the sponge, for backends requiring instruction set extensions, are compiled with those extensions enabled, so that the whole
+// loop, including the inlined Keccak-p[1600] permutation, benefits from them.
+namespace bmi {
+
+template<size_t num_bits_in_rate, size_t num_rounds>
+SHA3_TARGET_BMI static inline void
+absorb(std::array<uint64_t, keccak::LANE_CNT>& state, size_t& offset, std::span<const uint8_t> msg)
+{
+  absorb_using<num_bits_in_rate, num_rounds, keccak::backend_t::bmi>(state, offset, msg);
+}
+
+template<size_t num_bits_in_rate, size_t num_rounds>
+SHA3_TARGET_BMI static inline void
+squeeze(std::array<uint64_t, keccak::LANE_CNT>& state, size_t& squeezable, std::span<uint8_t> out)
+{
+  squeeze_using<num_bits_in_rate, num_rounds, keccak::backend_t::bmi>(state, squeezable, out);
+}
+
+}
+
+namespace avx2 {
+
+template<size_t num_bits_in_rate, size_t num_rounds>
+SHA3_TARGET_AVX2 static inline void
+absorb(std::array<uint64_t, keccak::LANE_CNT>& state, size_t& offset, std::span<const uint8_t> msg)
+{
+  absorb_using<num_bits_in_rate, num_rounds, keccak::backend_t::avx2>(state, offset, msg);
+}
+
+template<size_t num_bits_in_rate, size_t num_rounds>
+SHA3_TARGET_AVX2 static inline void
+squeeze(std::array<uint64_t, keccak::LANE_CNT>& state, size_t& squeezable, std::span<uint8_t> out)
+{
+  squeeze_using<num_bits_in_rate, num_rounds, keccak::backend_t::avx2>(state, squeezable, out);
+}
+
+}
+
+namespace avx512 {
+
+template<size_t num_bits_in_rate, size_t num_rounds>
+SHA3_TARGET_AVX512 static inline void
+absorb(std::array<uint64_t, keccak::LANE_CNT>& state, size_t& offset, std::span<const uint8_t> msg)
+{
+  absorb_using<num_bits_in_rate, num_rounds, keccak::backend_t::avx512>(state, offset, msg);
+}
+
+template<size_t num_bits_in_rate, size_t num_rounds>
+SHA3_TARGET_AVX512 static inline void
+squeeze(std::array<uint64_t, keccak::LANE_CNT>& state, size_t& squeezable, std::span<uint8_t> out)
+{
+  squeeze_using<num_bits_in_rate, num_rounds, keccak::backend_t::avx512>(state, squeezable, out);
+}
+
+}
+
+#endif
+
+#if defined(SHA3_HAS_AARCH64_SHA3_BACKEND)
+
+namespace neon_sha3 {
+
+template<size_t num_bits_in_rate, size_t num_rounds>
+SHA3_TARGET_SHA3 static inline void
+absorb(std::array<uint64_t, keccak::LANE_CNT>& state, size_t& offset, std::span<const uint8_t> msg)
+{
+  absorb_using<num_bits_in_rate, num_rounds, keccak::backend_t::neon_sha3>(state, offset, msg);
+}
+
+template<size_t num_bits_in_rate, size_t num_rounds>
+SHA3_TARGET_SHA3 static inline void
+squeeze(std::array<uint64_t, keccak::LANE_CNT>& state, size_t& squeezable, std::span<uint8_t> out)
+{
+  squeeze_using<num_bits_in_rate, num_rounds, keccak::backend_t::neon_sha3>(state, squeezable, out);
+}
+
+}
+
+#endif
+
+// Returns absorb loop of the sponge, compiled for the requested backend, which must be supported by the CPU.
+template<size_t num_bits_in_rate, size_t num_rounds>
+static inline absorb_fn_t
+absorb_fn([[maybe_unused]] const keccak::backend_t backend)
+{
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+  switch (backend) {
+    case keccak::backend_t::avx512:
+      return avx512::absorb<num_bits_in_rate, num_rounds>;
+    case keccak::backend_t::avx2:
+      return avx2::absorb<num_bits_in_rate, num_rounds>;
+    case keccak::backend_t::bmi:
+      return bmi::absorb<num_bits_in_rate, num_rounds>;
+    case keccak::backend_t::neon_sha3:
+    case keccak::backend_t::scalar:
+      break;
+  }
+#elif defined(SHA3_HAS_AARCH64_SHA3_BACKEND)
+  if (backend == keccak::backend_t::neon_sha3) {
+    return neon_sha3::absorb<num_bits_in_rate, num_rounds>;
+  }
+#endif
+
+  return scalar::absorb<num_bits_in_rate, num_rounds>;
+}
+
+// Returns squeeze loop of the sponge, compiled for the requested backend, which must be supported by the CPU.
+template<size_t num_bits_in_rate, size_t num_rounds>
+static inline squeeze_fn_t
+squeeze_fn([[maybe_unused]] const keccak::backend_t backend)
+{
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+  switch (backend) {
+    case keccak::backend_t::avx512:
+      return avx512::squeeze<num_bits_in_rate, num_rounds>;
+    case keccak::backend_t::avx2:
+      return avx2::squeeze<num_bits_in_rate, num_rounds>;
+    case keccak::backend_t::bmi:
+      return bmi::squeeze<num_bits_in_rate, num_rounds>;
+    case keccak::backend_t::neon_sha3:
+    case keccak::backend_t::scalar:
+      break;
+  }
+#elif defined(SHA3_HAS_AARCH64_SHA3_BACKEND)
+  if (backend == keccak::backend_t::neon_sha3) {
+    return neon_sha3::squeeze<num_bits_in_rate, num_rounds>;
+  }
+#endif
+
+  return scalar::squeeze<num_bits_in_rate, num_rounds>;
+}
+
+// Absorb loop of the sponge, bound to the active backend, on first call.
+template<size_t num_bits_in_rate, size_t num_rounds>
+static inline void
+absorb_dispatched(std::array<uint64_t, keccak::LANE_CNT>& state, size_t& offset, std::span<const uint8_t> msg)
+{
+  static const absorb_fn_t absorb_fn_ptr = absorb_fn<num_bits_in_rate, num_rounds>(keccak::active_backend());
+  absorb_fn_ptr(state, offset, msg);
+}
+
+// Squeeze loop of the sponge, bound to the active backend, on first call.
+template<size_t num_bits_in_rate, size_t num_rounds>
+static inline void
+squeeze_dispatched(std::array<uint64_t, keccak::LANE_CNT>& state, size_t& squeezable, std::span<uint8_t> out)
+{
+  static const squeeze_fn_t squeeze_fn_ptr = squeeze_fn<num_bits_in_rate, num_rounds>(keccak::active_backend());
+  squeeze_fn_ptr(state, squeezable, out);
+}
+
+/**
+ * Given `mlen` (>=0) -bytes message, this routine consumes it into Keccak[c] permutation state s.t. `offset` ( second parameter ) denotes how many bytes are
+ * already consumed into rate portion of the state. See `absorb_using`.
+ *
+ * At runtime, absorb loop is bound to the active backend, see `keccak::active_backend`, on first call, while compile-time evaluation uses the portable one.
+ */
+template<size_t num_bits_in_rate, size_t num_rounds>
+static forceinline constexpr void
+absorb(std::array<uint64_t, keccak::LANE_CNT>& state, size_t& offset, std::span<const uint8_t> msg)
+{
+#if defined(SHA3_HAS_SIMD_BACKENDS)
+  if (!std::is_constant_evaluated()) {
+    absorb_dispatched<num_bits_in_rate, num_rounds>(state, offset, msg);
+    return;
+  }
+#endif
+
+  absorb_using<num_bits_in_rate, num_rounds>(state, offset, msg);
+}
+
+/**
+ * Given that Keccak[c] permutation state is finalized, this routine can be invoked for squeezing `olen` -bytes out of rate portion of the state. See
+ * `squeeze_using`.
+ *
+ * At runtime, squeeze loop is bound to the active backend, see `keccak::active_backend`, on first call, while compile-time evaluation uses the portable one.
+ */
+template<size_t num_bits_in_rate, size_t num_rounds>
+static forceinline constexpr void
+squeeze(std::array<uint64_t, keccak::LANE_CNT>& state, size_t& squeezable, std::span<uint8_t> out)
+{
+#if defined(SHA3_HAS_SIMD_BACKENDS)
+  if (!std::is_constant_evaluated()) {
+    squeeze_dispatched<num_bits_in_rate, num_rounds>(state, squeezable, out);
+    return;
+  }
+#endif
+
+  squeeze_using<num_bits_in_rate, num_rounds>(state, squeezable, out);
+}
+
+/**
+ * One-shot hashes `msg`, whose length `mlen` is known at compile-time, writing `out_len` ( <= `rate/ 8` ) -bytes of output. Number of full blocks, position
+ * of the message tail and of padding bits are all compile-time constants, so there is no offset bookkeeping, no staging buffer and, for messages shorter
+ * than `rate/ 8` -bytes, exactly one permutation. Output is same as `absorb`, `finalize` and `squeeze`, on a fresh state.
+ */
+template<uint8_t domain_separator, size_t ds_bit_len, size_t num_bits_in_rate, size_t num_rounds, size_t mlen, size_t out_len>
+static forceinline constexpr void
+hash_fixed_len(std::span<const uint8_t, mlen> msg, std::span<uint8_t, out_len> out)
+  requires(check_domain_separator(ds_bit_len) && (mlen != std::dynamic_extent) && (out_len <= num_bits_in_rate / std::numeric_limits<uint8_t>::digits))
+{
+  constexpr size_t num_bytes_in_rate = num_bits_in_rate / std::numeric_limits<uint8_t>::digits;
+  constexpr size_t full_blocks_byte_len = mlen - (mlen % num_bytes_in_rate);
+  constexpr size_t tail_byte_len = mlen - full_blocks_byte_len;
+
+  std::array<uint64_t, keccak::LANE_CNT> state{};
+
+  if constexpr (full_blocks_byte_len > 0) {
+    size_t offset = 0;
+    absorb<num_bits_in_rate, num_rounds>(state, offset, msg.template first<full_blocks_byte_len>());
+  }
+
+  const auto tail = msg.template last<tail_byte_len>();
+
+  for (size_t i = 0; i < (tail_byte_len / KECCAK_WORD_BYTE_LEN); i++) {
+    state[i] ^= sha3_utils::le_bytes_to_u64(tail.subspan(i * KECCAK_WORD_BYTE_LEN).template first<KECCAK_WORD_BYTE_LEN>());
+  }
+
+  if constexpr ((tail_byte_len % KECCAK_WORD_BYTE_LEN) != 0) {
+    constexpr size_t tail_word_index = tail_byte_len / KECCAK_WORD_BYTE_LEN;
+
+    uint64_t word = 0;
+    for (size_t k = 0; k < (tail_byte_len % KECCAK_WORD_BYTE_LEN); k++) {
+      word |= static_cast<uint64_t>(tail[(tail_word_index * KECCAK_WORD_BYTE_LEN) + k]) << (k * std::numeric_limits<uint8_t>::digits);
+    }
+
+    state[tail_word_index] ^= word;
+  }
+
+  pad<domain_separator, ds_bit_len, num_bits_in_rate>(state, tail_byte_len);
+  keccak::permute<num_rounds>(state);
+
+  for (size_t i = 0; i < (out_len / KECCAK_WORD_BYTE_LEN); i++) {
+    sha3_utils::u64_to_le_bytes(state[i], out.subspan(i * KECCAK_WORD_BYTE_LEN).template first<KECCAK_WORD_BYTE_LEN>());
+  }
+
+  if constexpr ((out_len % KECCAK_WORD_BYTE_LEN) != 0) {
+    constexpr size_t out_word_index = out_len / KECCAK_WORD_BYTE_LEN;
+
+    for (size_t k = 0; k < (out_len % KECCAK_WORD_BYTE_LEN); k++) {
+      out[(out_word_index * KECCAK_WORD_BYTE_LEN) + k] = static_cast<uint8_t>(state[out_word_index] >> (k * std::numeric_limits<uint8_t>::digits));
+    }
+  }
+}
+
 }
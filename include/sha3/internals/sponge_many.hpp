@@ -0,0 +1,161 @@
+#pragma once
+#include "sha3/internals/keccak.hpp"
+#include "sha3/internals/keccak_x4.hpp"
+#include "sha3/internals/sponge.hpp"
+#include "sha3/internals/state_batch.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <vector>
+
+// Batched one-shot hashing of many independent messages, using multi-buffer Keccak-p[1600] permutation
+namespace sponge {
+
+// # -of messages, hashed together in lanes of multi-buffer Keccak-p[1600] permutation, by `hash_many`.
+static constexpr size_t HASH_MANY_LANE_CNT = keccak::X4_STATE_CNT;
+
+// One-shot hashes a single message `msg`, writing `out.size()` -bytes of output, on the scalar path.
+template<uint8_t domain_separator, size_t ds_bit_len, size_t num_bits_in_rate, size_t num_rounds>
+static inline void
+hash_one(std::span<const uint8_t> msg, std::span<uint8_t> out)
+{
+  std::array<uint64_t, keccak::LANE_CNT> state{};
+  size_t offset = 0;
+
+  absorb<num_bits_in_rate, num_rounds>(state, offset, msg);
+  finalize<domain_separator, ds_bit_len, num_bits_in_rate, num_rounds>(state, offset);
+
+  size_t squeezable = num_bits_in_rate / std::numeric_limits<uint8_t>::digits;
+  squeeze<num_bits_in_rate, num_rounds>(state, squeezable, out);
+}
+
+/**
+ * One-shot hashes four messages, together, in lanes of `keccak::permute_x4`. Full blocks, common to all four messages, are absorbed in lockstep. If all
+ * messages have the same number of full blocks, their tails get padded and the whole squeeze phase also runs in lockstep, as long as all outputs are of same
+ * length. Otherwise, each state is taken out of the batch and finished on the scalar path, which is cheap when message lengths are close to each other.
+ */
+template<uint8_t domain_separator, size_t ds_bit_len, size_t num_bits_in_rate, size_t num_rounds>
+static inline void
+hash_x4(const std::array<std::span<const uint8_t>, HASH_MANY_LANE_CNT>& msgs, const std::array<std::span<uint8_t>, HASH_MANY_LANE_CNT>& outs)
+{
+  constexpr size_t num_bytes_in_rate = num_bits_in_rate / std::numeric_limits<uint8_t>::digits;
+
+  keccak::state_batch<HASH_MANY_LANE_CNT> states{};
+
+  const auto shortest = std::ranges::min(msgs, {}, [](const auto msg) { return msg.size(); });
+  const size_t common_blocks_byte_len = shortest.size() - (shortest.size() % num_bytes_in_rate);
+
+  for (size_t block_offset = 0; block_offset < common_blocks_byte_len; block_offset += num_bytes_in_rate) {
+    for (size_t j = 0; j < HASH_MANY_LANE_CNT; j++) {
+      states.absorb_block<num_bits_in_rate>(j, msgs[j].subspan(block_offset).first<num_bytes_in_rate>());
+    }
+
+    states.permute<num_rounds>();
+  }
+
+  const bool tails_fit_in_a_block = std::ranges::all_of(msgs, [&](const auto msg) { return msg.size() - common_blocks_byte_len < num_bytes_in_rate; });
+  const bool same_output_len = std::ranges::all_of(outs, [&](const auto out) { return out.size() == outs[0].size(); });
+
+  std::array<uint64_t, keccak::LANE_CNT> state{};
+
+  if (!tails_fit_in_a_block || !same_output_len) {
+    for (size_t j = 0; j < HASH_MANY_LANE_CNT; j++) {
+      states.load(j, state);
+
+      size_t offset = 0;
+      absorb<num_bits_in_rate, num_rounds>(state, offset, msgs[j].subspan(common_blocks_byte_len));
+      finalize<domain_separator, ds_bit_len, num_bits_in_rate, num_rounds>(state, offset);
+
+      size_t squeezable = num_bytes_in_rate;
+      squeeze<num_bits_in_rate, num_rounds>(state, squeezable, outs[j]);
+    }
+
+    return;
+  }
+
+  // Message tails and padding are XORed into each state, on the scalar path, as none of them needs a permutation.
+  for (size_t j = 0; j < HASH_MANY_LANE_CNT; j++) {
+    states.load(j, state);
+
+    const auto tail = msgs[j].subspan(common_blocks_byte_len);
+    size_t offset = 0;
+
+    absorb_using<num_bits_in_rate, num_rounds>(state, offset, tail);
+    pad<domain_separator, ds_bit_len, num_bits_in_rate>(state, offset);
+    states.store(j, state);
+  }
+
+  const size_t out_len = outs[0].size();
+  for (size_t out_offset = 0; out_offset < out_len; out_offset += num_bytes_in_rate) {
+    states.permute<num_rounds>();
+
+    const size_t chunk_byte_len = std::min(num_bytes_in_rate, out_len - out_offset);
+    for (size_t j = 0; j < HASH_MANY_LANE_CNT; j++) {
+      states.squeeze_bytes(j, 0, outs[j].subspan(out_offset, chunk_byte_len));
+    }
+  }
+}
+
+/**
+ * One-shot hashes `msg_cnt` independent messages, where `msg_at(i)` returns i-th message, as `std::span<const uint8_t>`, and `out_at(i)` returns span of
+ * bytes, where its output is written. Output is bit-identical to absorbing, finalizing and squeezing each message on its own.
+ *
+ * Messages are ordered by their number of full `rate/ 8` -byte blocks, s.t. messages of similar length end up in the same group of `HASH_MANY_LANE_CNT`,
+ * which is hashed using `hash_x4`. Messages left over, after forming groups, are hashed on the scalar path.
+ */
+template<uint8_t domain_separator, size_t ds_bit_len, size_t num_bits_in_rate, size_t num_rounds, typename msg_at_t, typename out_at_t>
+static inline void
+hash_many(const size_t msg_cnt, msg_at_t&& msg_at, out_at_t&& out_at)
+  requires(check_domain_separator(ds_bit_len))
+{
+  constexpr size_t num_bytes_in_rate = num_bits_in_rate / std::numeric_limits<uint8_t>::digits;
+
+  std::vector<size_t> order(msg_cnt);
+  std::iota(order.begin(), order.end(), 0);
+
+  const auto block_cnt = [&](const size_t idx) { return msg_at(idx).size() / num_bytes_in_rate; };
+  if (!std::ranges::is_sorted(order, {}, block_cnt)) {
+    std::ranges::stable_sort(order, {}, block_cnt);
+  }
+
+  const size_t grouped_msg_cnt = msg_cnt - (msg_cnt % HASH_MANY_LANE_CNT);
+
+  for (size_t off = 0; off < grouped_msg_cnt; off += HASH_MANY_LANE_CNT) {
+    std::array<std::span<const uint8_t>, HASH_MANY_LANE_CNT> msgs{};
+    std::array<std::span<uint8_t>, HASH_MANY_LANE_CNT> outs{};
+
+    for (size_t j = 0; j < HASH_MANY_LANE_CNT; j++) {
+      msgs[j] = msg_at(order[off + j]);
+      outs[j] = out_at(order[off + j]);
+    }
+
+    hash_x4<domain_separator, ds_bit_len, num_bits_in_rate, num_rounds>(msgs, outs);
+  }
+
+  for (size_t off = grouped_msg_cnt; off < msg_cnt; off++) {
+    hash_one<domain_separator, ds_bit_len, num_bits_in_rate, num_rounds>(msg_at(order[off]), out_at(order[off]));
+  }
+}
+
+/**
+ * Returns # -of records, each of `record_len` -bytes, laid out at a fixed `stride` in `records` i.e. i-th one starts at byte offset `i * stride`, which fit
+ * in it, capped at `max_cnt`.
+ */
+static inline size_t
+strided_record_cnt(std::span<const uint8_t> records, const size_t record_len, const size_t stride, const size_t max_cnt)
+{
+  if (records.size() < record_len) {
+    return 0;
+  }
+  if (stride == 0) {
+    return max_cnt;
+  }
+
+  return std::min(max_cnt, ((records.size() - record_len) / stride) + 1);
+}
+
+}
@@ -0,0 +1,157 @@
+#pragma once
+#include "sha3/internals/force_inline.hpp"
+#include "sha3/internals/keccak.hpp"
+#include "sha3/internals/keccak_x2.hpp"
+#include "sha3/internals/keccak_x4.hpp"
+#include "sha3/internals/keccak_x8.hpp"
+#include "sha3/internals/utils.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+// Structure-of-arrays batch of Keccak-p[1600] permutation states
+namespace keccak {
+
+/**
+ * Batch of `state_cnt` (2, 4 or 8) independent Keccak-p[1600] permutation states, stored lane-major i.e. lane `i` of all states comes before lane `i + 1`,
+ * with lane `i` of state `j` living at index `i * state_cnt + j`. This is exactly the layout multi-buffer permutations `permute_x2`, `permute_x4` and
+ * `permute_x8` work on, and storage is 64 -byte aligned, so a row of lanes can be loaded without gather or transpose.
+ *
+ * State `j`, also called column `j`, can be absorbed into and squeezed from on its own, while all columns are permuted together. Keeping many sponges of the
+ * same kind, say XOF instances expanding a matrix, in a batch, saves transposing them for every permutation.
+ */
+template<size_t state_cnt>
+  requires((state_cnt == X2_STATE_CNT) || (state_cnt == X4_STATE_CNT) || (state_cnt == X8_STATE_CNT))
+struct state_batch
+{
+private:
+  alignas(64) std::array<uint64_t, LANE_CNT * state_cnt> lanes{};
+
+  // XORs `bytes.size()` ( <= 8 - `shift` ) -bytes into lane `i` of state `j`, starting at byte `shift` of that lane.
+  forceinline constexpr void xor_partial_lane(const size_t i, const size_t j, const size_t shift, std::span<const uint8_t> bytes)
+  {
+    uint64_t word = 0;
+    for (size_t k = 0; k < bytes.size(); k++) {
+      word |= static_cast<uint64_t>(bytes[k]) << ((shift + k) * std::numeric_limits<uint8_t>::digits);
+    }
+
+    lanes[(i * state_cnt) + j] ^= word;
+  }
+
+  // Serializes `bytes.size()` ( <= 8 - `shift` ) -bytes out of lane `i` of state `j`, starting at byte `shift` of that lane.
+  forceinline constexpr void copy_partial_lane(const size_t i, const size_t j, const size_t shift, std::span<uint8_t> bytes) const
+  {
+    const uint64_t word = lanes[(i * state_cnt) + j];
+    for (size_t k = 0; k < bytes.size(); k++) {
+      bytes[k] = static_cast<uint8_t>(word >> ((shift + k) * std::numeric_limits<uint8_t>::digits));
+    }
+  }
+
+public:
+  // # -of independent states in this batch.
+  static constexpr size_t STATE_CNT = state_cnt;
+
+  // Lane-major interleaved storage of all states, ready to be permuted by a multi-buffer permutation.
+  [[nodiscard]] forceinline constexpr std::span<uint64_t, LANE_CNT * state_cnt> data() { return lanes; }
+  [[nodiscard]] forceinline constexpr std::span<const uint64_t, LANE_CNT * state_cnt> data() const { return lanes; }
+
+  // Returns lane `i` of state `j`.
+  [[nodiscard]] forceinline constexpr uint64_t& lane(const size_t i, const size_t j) { return lanes[(i * state_cnt) + j]; }
+  [[nodiscard]] forceinline constexpr uint64_t lane(const size_t i, const size_t j) const { return lanes[(i * state_cnt) + j]; }
+
+  // Zeroes all states.
+  forceinline constexpr void reset() { lanes.fill(0); }
+
+  // Copies state `j` into `state`.
+  forceinline constexpr void load(const size_t j, std::array<uint64_t, LANE_CNT>& state) const
+  {
+    for (size_t i = 0; i < LANE_CNT; i++) {
+      state[i] = lanes[(i * state_cnt) + j];
+    }
+  }
+
+  // Copies `state` into state `j`.
+  forceinline constexpr void store(const size_t j, const std::array<uint64_t, LANE_CNT>& state)
+  {
+    for (size_t i = 0; i < LANE_CNT; i++) {
+      lanes[(i * state_cnt) + j] = state[i];
+    }
+  }
+
+  // XORs full `rate/ 8` -bytes `block` into rate portion of state `j`.
+  template<size_t num_bits_in_rate>
+  forceinline constexpr void absorb_block(const size_t j, std::span<const uint8_t, num_bits_in_rate / std::numeric_limits<uint8_t>::digits> block)
+  {
+    constexpr size_t num_words_in_rate = num_bits_in_rate / std::numeric_limits<uint64_t>::digits;
+
+    for (size_t i = 0; i < num_words_in_rate; i++) {
+      auto msg_chunk = std::span<const uint8_t, sizeof(uint64_t)>(block.subspan(i * sizeof(uint64_t), sizeof(uint64_t)));
+      lanes[(i * state_cnt) + j] ^= sha3_utils::le_bytes_to_u64(msg_chunk);
+    }
+  }
+
+  /**
+   * XORs `bytes` into state `j`, starting at byte `offset` of the state, s.t. `offset + bytes.size()` must not exceed `STATE_BYTE_LEN`. Doesn't permute,
+   * so the caller tracks rate offset of the column and permutes the batch, once all columns have a full rate absorbed.
+   */
+  forceinline constexpr void absorb_bytes(const size_t j, const size_t offset, std::span<const uint8_t> bytes)
+  {
+    size_t i = offset / sizeof(uint64_t);
+    const size_t shift = offset % sizeof(uint64_t);
+    size_t consumed = 0;
+
+    if (shift != 0) {
+      consumed = std::min(bytes.size(), sizeof(uint64_t) - shift);
+      xor_partial_lane(i++, j, shift, bytes.first(consumed));
+    }
+
+    for (; (bytes.size() - consumed) >= sizeof(uint64_t); consumed += sizeof(uint64_t)) {
+      auto msg_chunk = std::span<const uint8_t, sizeof(uint64_t)>(bytes.subspan(consumed, sizeof(uint64_t)));
+      lanes[(i++ * state_cnt) + j] ^= sha3_utils::le_bytes_to_u64(msg_chunk);
+    }
+
+    if (consumed < bytes.size()) {
+      xor_partial_lane(i, j, 0, bytes.subspan(consumed));
+    }
+  }
+
+  // Serializes `out.size()` -bytes of state `j`, starting at byte `offset` of the state, into `out`, s.t. `offset + out.size()` can't exceed `STATE_BYTE_LEN`.
+  forceinline constexpr void squeeze_bytes(const size_t j, const size_t offset, std::span<uint8_t> out) const
+  {
+    size_t i = offset / sizeof(uint64_t);
+    const size_t shift = offset % sizeof(uint64_t);
+    size_t produced = 0;
+
+    if (shift != 0) {
+      produced = std::min(out.size(), sizeof(uint64_t) - shift);
+      copy_partial_lane(i++, j, shift, out.first(produced));
+    }
+
+    for (; (out.size() - produced) >= sizeof(uint64_t); produced += sizeof(uint64_t)) {
+      auto out_chunk = std::span<uint8_t, sizeof(uint64_t)>(out.subspan(produced, sizeof(uint64_t)));
+      sha3_utils::u64_to_le_bytes(lanes[(i++ * state_cnt) + j], out_chunk);
+    }
+
+    if (produced < out.size()) {
+      copy_partial_lane(i, j, 0, out.subspan(produced));
+    }
+  }
+
+  // Applies Keccak-p[1600, `num_rounds`] permutation on all states, together, using the matching multi-buffer permutation.
+  template<size_t num_rounds>
+  forceinline constexpr void permute()
+  {
+    if constexpr (state_cnt == X2_STATE_CNT) {
+      permute_x2<num_rounds>(lanes);
+    } else if constexpr (state_cnt == X4_STATE_CNT) {
+      permute_x4<num_rounds>(lanes);
+    } else {
+      permute_x8<num_rounds>(lanes);
+    }
+  }
+};
+
+}
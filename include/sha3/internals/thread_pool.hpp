@@ -0,0 +1,134 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <latch>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Fixed size pool of worker threads, for spreading independent pieces of work, say leaves of a tree hash, across CPU cores
+namespace sha3_utils {
+
+/**
+ * Pool of `thread_cnt - 1` worker threads, which, along with the thread calling `parallel_for`, keep `thread_cnt` CPU cores busy. Workers are spawned once,
+ * in the constructor, and joined in the destructor, after finishing all submitted tasks, so that a pool can be reused across many calls, saving thread
+ * creation cost for each of them.
+ *
+ * A pool of a single thread has no worker, it runs everything on the calling thread.
+ */
+struct thread_pool_t
+{
+private:
+  std::vector<std::thread> workers;
+  std::deque<std::function<void()>> tasks;
+  std::mutex mutex;
+  std::condition_variable task_available;
+  bool stopping = false;
+
+  // Body of each worker thread, running tasks, in order of submission, until the pool is being destroyed and no task is left.
+  void run_worker()
+  {
+    while (true) {
+      std::function<void()> task;
+
+      {
+        std::unique_lock lock(mutex);
+        task_available.wait(lock, [&]() { return stopping || !tasks.empty(); });
+
+        if (tasks.empty()) {
+          return;
+        }
+
+        task = std::move(tasks.front());
+        tasks.pop_front();
+      }
+
+      task();
+    }
+  }
+
+public:
+  // Creates a pool, keeping `thread_cnt` ( >= 1 ) threads busy, including the calling one. Defaults to # -of hardware threads.
+  explicit thread_pool_t(const size_t thread_cnt = std::max<size_t>(std::thread::hardware_concurrency(), 1))
+  {
+    const size_t worker_cnt = std::max<size_t>(thread_cnt, 1) - 1;
+
+    workers.reserve(worker_cnt);
+    for (size_t i = 0; i < worker_cnt; i++) {
+      workers.emplace_back([this]() { run_worker(); });
+    }
+  }
+
+  thread_pool_t(const thread_pool_t&) = delete;
+  thread_pool_t& operator=(const thread_pool_t&) = delete;
+  thread_pool_t(thread_pool_t&&) = delete;
+  thread_pool_t& operator=(thread_pool_t&&) = delete;
+
+  ~thread_pool_t()
+  {
+    {
+      std::scoped_lock lock(mutex);
+      stopping = true;
+    }
+
+    task_available.notify_all();
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
+
+  // # -of threads kept busy by this pool, including the one calling `parallel_for`.
+  [[nodiscard]] size_t thread_cnt() const { return workers.size() + 1; }
+
+  // Queues `task` for running on one of the workers. When the pool has no worker, `task` is run right away, on the calling thread.
+  void submit(std::function<void()> task)
+  {
+    if (workers.empty()) {
+      task();
+      return;
+    }
+
+    {
+      std::scoped_lock lock(mutex);
+      tasks.push_back(std::move(task));
+    }
+
+    task_available.notify_one();
+  }
+
+  /**
+   * Calls `fn(i)`, for each i < `task_cnt`, spread across workers and the calling thread, which pick next i, as soon as they are done with the previous one,
+   * and returns once all of them are done. Calls for different i must be independent of each other.
+   */
+  template<typename fn_t>
+  void parallel_for(const size_t task_cnt, fn_t&& fn)
+  {
+    std::atomic<size_t> next_task{ 0 };
+
+    const auto run_tasks = [&]() {
+      for (size_t i = next_task.fetch_add(1, std::memory_order_relaxed); i < task_cnt; i = next_task.fetch_add(1, std::memory_order_relaxed)) {
+        fn(i);
+      }
+    };
+
+    const auto helper_cnt = static_cast<std::ptrdiff_t>(std::min(workers.size(), task_cnt - std::min<size_t>(task_cnt, 1)));
+    std::latch helpers_done(helper_cnt);
+
+    for (std::ptrdiff_t i = 0; i < helper_cnt; i++) {
+      submit([&]() {
+        run_tasks();
+        helpers_done.count_down();
+      });
+    }
+
+    run_tasks();
+    helpers_done.wait();
+  }
+};
+
+}
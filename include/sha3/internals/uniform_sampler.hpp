@@ -0,0 +1,199 @@
+#pragma once
+#include "sha3/internals/cpu_features.hpp"
+#include "sha3/internals/force_inline.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+#include <immintrin.h>
+#endif
+
+// Rejection sampling of integers, uniform in [0, q), out of XOF output
+namespace sponge {
+
+// Each candidate is parsed out of these many bytes of XOF output, when q > 2^12, otherwise two candidates are parsed out of them.
+static constexpr size_t SAMPLER_CHUNK_BYTE_LEN = 3;
+
+/**
+ * Modulus `q` can be sampled into elements of type `T`, iff candidates, which are `bit_width(q - 1)` -bits wide, fit in `T` and in a 3 -byte chunk of XOF
+ * output.
+ */
+template<uint32_t q, typename T>
+concept sampleable = (std::same_as<T, uint16_t> || std::same_as<T, uint32_t>) && (q >= 2) &&
+                     (std::bit_width(q - 1) <= std::min<size_t>(std::numeric_limits<T>::digits, SAMPLER_CHUNK_BYTE_LEN * 8));
+
+// Candidates of moduli, no wider than 12 -bits, are packed two per 3 -byte chunk, as done by SampleNTT of ML-KEM ( FIPS 203 ).
+template<uint32_t q>
+static constexpr bool packs_two_candidates = std::bit_width(q - 1) <= 12;
+
+/**
+ * Rejection samples values < `q` out of whole 3 -byte chunks of `bytes`, writing accepted ones to `out`, starting at index `ctr`, until either `out` is full
+ * or less than a chunk is left. Returns # -of bytes consumed.
+ *
+ * If `q` fits in 12 -bits, each chunk `b0, b1, b2` yields two 12 -bit candidates `b0 | (b1 & 0xf) << 8` and `b1 >> 4 | b2 << 4`, otherwise it yields a single
+ * candidate, which is the low `bit_width(q - 1)` -bits of `b0 | b1 << 8 | b2 << 16`. With q = 3329 and q = 8380417, this is exactly how ML-KEM and ML-DSA
+ * ( FIPS 204 ) sample their public matrices.
+ */
+template<uint32_t q, typename T>
+static forceinline size_t
+sample_scalar(std::span<const uint8_t> bytes, std::span<T> out, size_t& ctr)
+  requires(sampleable<q, T>)
+{
+  constexpr uint32_t mask = packs_two_candidates<q> ? 0xfffU : ((1U << std::bit_width(q - 1)) - 1U);
+
+  size_t off = 0;
+  for (; ((off + SAMPLER_CHUNK_BYTE_LEN) <= bytes.size()) && (ctr < out.size()); off += SAMPLER_CHUNK_BYTE_LEN) {
+    const uint32_t word = static_cast<uint32_t>(bytes[off]) | (static_cast<uint32_t>(bytes[off + 1]) << 8U) | (static_cast<uint32_t>(bytes[off + 2]) << 16U);
+
+    const uint32_t cand0 = word & mask;
+    if (cand0 < q) {
+      out[ctr++] = static_cast<T>(cand0);
+    }
+
+    if constexpr (packs_two_candidates<q>) {
+      const uint32_t cand1 = word >> 12U;
+      if ((cand1 < q) && (ctr < out.size())) {
+        out[ctr++] = static_cast<T>(cand1);
+      }
+    }
+  }
+
+  return off;
+}
+
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+
+// AVX2 rejection sampler, parsing eight candidates at a time into 32 -bit lanes, comparing them against q and compacting accepted ones using a table lookup.
+namespace avx2 {
+
+// For each 8 -bit mask, indices of its set bits, in ascending order, packed into consecutive bytes, starting from the least significant one.
+static constexpr auto COMPACTION_INDICES = []() {
+  std::array<uint64_t, 256> table{};
+
+  for (size_t mask = 0; mask < table.size(); mask++) {
+    size_t k = 0;
+    for (size_t i = 0; i < 8; i++) {
+      if (((mask >> i) & 1U) == 1U) {
+        table[mask] |= static_cast<uint64_t>(i) << (8 * k++);
+      }
+    }
+  }
+
+  return table;
+}();
+
+/**
+ * Same as `sponge::sample_scalar`, but stops as soon as less than a full SIMD step of input or output is left, so that each step can load and store without
+ * bounds checks. Returns # -of bytes consumed, which is always a multiple of 3 -bytes, so that the scalar sampler can take over.
+ */
+template<uint32_t q, typename T>
+SHA3_TARGET_AVX2 static inline size_t
+sample(std::span<const uint8_t> bytes, std::span<T> out, size_t& ctr)
+  requires(sampleable<q, T>)
+{
+  constexpr size_t CANDIDATE_CNT = 8;
+
+  // Two candidates per chunk: 12 bytes are consumed, but a 16 -byte load is issued. One candidate per chunk: 24 bytes are consumed, by two 16 -byte loads.
+  constexpr size_t step_byte_len = packs_two_candidates<q> ? 12 : 24;
+  constexpr size_t load_byte_len = packs_two_candidates<q> ? 16 : 28;
+
+  const __m256i modulus = _mm256_set1_epi32(static_cast<int>(q));
+  __m256i shuffle{};
+  __m256i shift{};
+  __m256i mask{};
+
+  if constexpr (packs_two_candidates<q>) {
+    // Lane `2k` gets bytes `3k, 3k + 1` and lane `2k + 1` gets bytes `3k + 1, 3k + 2`, later shifted right by 4 -bits.
+    shuffle = _mm256_setr_epi8(0, 1, -1, -1, 1, 2, -1, -1, 3, 4, -1, -1, 4, 5, -1, -1, 6, 7, -1, -1, 7, 8, -1, -1, 9, 10, -1, -1, 10, 11, -1, -1);
+    shift = _mm256_setr_epi32(0, 4, 0, 4, 0, 4, 0, 4);
+    mask = _mm256_set1_epi32(0xfff);
+  } else {
+    // Lane `k` of each 128 -bit half gets bytes `3k, 3k + 1, 3k + 2` of 12 bytes, loaded into that half.
+    shuffle = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    shift = _mm256_setzero_si256();
+    mask = _mm256_set1_epi32(static_cast<int>((1U << std::bit_width(q - 1)) - 1U));
+  }
+
+  size_t off = 0;
+  for (; ((off + load_byte_len) <= bytes.size()) && ((ctr + CANDIDATE_CNT) <= out.size()); off += step_byte_len) {
+    const auto* src = bytes.subspan(off).data();
+
+    __m256i chunks{};
+    if constexpr (packs_two_candidates<q>) {
+      chunks = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src))); // NOLINT
+    } else {
+      const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));      // NOLINT
+      const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 12)); // NOLINT
+      chunks = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    }
+
+    const __m256i cands = _mm256_and_si256(_mm256_srlv_epi32(_mm256_shuffle_epi8(chunks, shuffle), shift), mask);
+    const __m256i accepted = _mm256_cmpgt_epi32(modulus, cands);
+    const auto accepted_mask = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(accepted)));
+
+    const __m256i indices = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(static_cast<long long>(COMPACTION_INDICES[accepted_mask])));
+    const __m256i compacted = _mm256_permutevar8x32_epi32(cands, indices);
+
+    auto* dst = out.subspan(ctr).data();
+    if constexpr (std::same_as<T, uint32_t>) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), compacted); // NOLINT
+    } else {
+      const __m128i packed = _mm_packus_epi32(_mm256_castsi256_si128(compacted), _mm256_extracti128_si256(compacted, 1));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), packed); // NOLINT
+    }
+
+    ctr += static_cast<size_t>(std::popcount(accepted_mask));
+  }
+
+  return off;
+}
+
+}
+
+#endif
+
+/**
+ * Fills `out` with values uniform in [0, `q`), by rejection sampling output of `xof`, which must be finalized and which has rate of `num_bits_in_rate`. See
+ * `sample_scalar` for how candidates are parsed out of XOF output. The XOF is squeezed a full block at a time, with chunks straddling two blocks carried over,
+ * so `out` is same as what parsing XOF output, 3 -bytes at a time, yields, while the XOF gets squeezed past the last chunk used.
+ *
+ * Uses AVX2, for parsing and compacting eight candidates at a time, when the CPU supports it.
+ */
+template<uint32_t q, size_t num_bits_in_rate, typename xof_t, typename T>
+static inline void
+sample_uniform(xof_t& xof, std::span<T> out)
+  requires(sampleable<q, T>)
+{
+  constexpr size_t num_bytes_in_rate = num_bits_in_rate / std::numeric_limits<uint8_t>::digits;
+
+  // Less than a chunk of bytes, left over from previous block, followed by a fresh block.
+  std::array<uint8_t, (SAMPLER_CHUNK_BYTE_LEN - 1) + num_bytes_in_rate> buffer{};
+  size_t carry = 0;
+  size_t ctr = 0;
+
+  while (ctr < out.size()) {
+    xof.squeeze(std::span(buffer).subspan(carry, num_bytes_in_rate));
+
+    const auto bytes = std::span<const uint8_t>(buffer).first(carry + num_bytes_in_rate);
+    size_t consumed = 0;
+
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+    if (cpu_features::has_avx2()) {
+      consumed = avx2::sample<q>(bytes, out, ctr);
+    }
+#endif
+
+    consumed += sample_scalar<q>(bytes.subspan(consumed), out, ctr);
+
+    carry = bytes.size() - consumed;
+    std::copy_n(bytes.subspan(consumed).begin(), carry, buffer.begin());
+  }
+}
+
+}
@@ -1,29 +1,45 @@
 #pragma once
 #include "sha3/internals/force_inline.hpp"
+#include <bit>
 #include <cassert>
 #include <cstdint>
+#include <cstring>
 #include <span>
+#include <type_traits>
 
 // Commonly used functions for SHA3 implementation
 namespace sha3_utils {
 
-// Given a byte array of length 8, this routine can be used for interpreting those 8 -bytes in little-endian order, as a 64 -bit unsigned integer.
+// Given a byte array of length 8, this routine can be used for interpreting those 8 -bytes in little-endian order, as a 64 -bit unsigned integer. At runtime,
+// it is a single unaligned load, while compile-time evaluation assembles the word byte by byte.
 static forceinline constexpr uint64_t
 le_bytes_to_u64(std::span<const uint8_t, sizeof(uint64_t)> bytes)
 {
   static_assert(std::endian::native == std::endian::little);
 
+  if (!std::is_constant_evaluated()) {
+    uint64_t word = 0;
+    std::memcpy(&word, bytes.data(), sizeof(word));
+    return word;
+  }
+
   return (static_cast<uint64_t>(bytes[7]) << 56U) | (static_cast<uint64_t>(bytes[6]) << 48U) | (static_cast<uint64_t>(bytes[5]) << 40U) |
          (static_cast<uint64_t>(bytes[4]) << 32U) | (static_cast<uint64_t>(bytes[3]) << 24U) | (static_cast<uint64_t>(bytes[2]) << 16U) |
          (static_cast<uint64_t>(bytes[1]) << 8U) | (static_cast<uint64_t>(bytes[0]) << 0U);
 }
 
-// Given a 64 -bit unsigned integer as input, this routine can be used for interpreting those 8 -bytes in little-endian byte order.
+// Given a 64 -bit unsigned integer as input, this routine can be used for interpreting those 8 -bytes in little-endian byte order. At runtime, it is a single
+// unaligned store, while compile-time evaluation writes the word byte by byte.
 static forceinline constexpr void
 u64_to_le_bytes(uint64_t word, std::span<uint8_t, sizeof(word)> bytes)
 {
   static_assert(std::endian::native == std::endian::little);
 
+  if (!std::is_constant_evaluated()) {
+    std::memcpy(bytes.data(), &word, sizeof(word));
+    return;
+  }
+
   bytes[0] = static_cast<uint8_t>(word >> 0U);
   bytes[1] = static_cast<uint8_t>(word >> 8U);
   bytes[2] = static_cast<uint8_t>(word >> 16U);
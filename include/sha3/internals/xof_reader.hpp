@@ -0,0 +1,108 @@
+#pragma once
+#include "sha3/internals/force_inline.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+
+// Buffered reader, handing out few bytes at a time, out of a finalized XOF
+namespace sponge {
+
+/**
+ * Buffered reader over output of a finalized XOF `xof_t` (e.g. `shake128::shake128_t`), meant for rejection samplers, which consume two or three bytes at a
+ * time. Output of the XOF is squeezed `block_cnt` full `rate/ 8` -byte blocks at a time, into a buffer, from which bytes, `uint16_t` or `uint32_t` values
+ * are handed out, with a single bounds check on the common path. Sequence of bytes handed out is same as squeezing the XOF directly.
+ *
+ * The XOF is borrowed, it must outlive the reader and must not be squeezed directly while the reader is in use, as the reader squeezes ahead of what it hands
+ * out.
+ */
+template<typename xof_t, size_t num_bits_in_rate, size_t block_cnt = 1>
+  requires(block_cnt > 0)
+struct xof_reader_t
+{
+public:
+  // Byte length of the buffer, refilled by squeezing the XOF.
+  static constexpr size_t BUFFER_BYTE_LEN = block_cnt * (num_bits_in_rate / std::numeric_limits<uint8_t>::digits);
+
+private:
+  xof_t& xof;
+  std::array<uint8_t, BUFFER_BYTE_LEN> buffer{};
+  size_t buffer_offset = BUFFER_BYTE_LEN; // Index of the next byte to be handed out, buffer is empty when it's BUFFER_BYTE_LEN
+
+  // Refills whole buffer, by squeezing next `BUFFER_BYTE_LEN` -bytes out of the XOF.
+  forceinline void refill()
+  {
+    xof.squeeze(buffer);
+    buffer_offset = 0;
+  }
+
+  // Slow path of `read`, for requests crossing end of the buffer.
+  void read_across_refills(std::span<uint8_t> out)
+  {
+    size_t out_offset = 0;
+    while (out_offset < out.size()) {
+      if (buffer_offset == BUFFER_BYTE_LEN) {
+        refill();
+      }
+
+      const size_t readable_num_bytes = std::min(BUFFER_BYTE_LEN - buffer_offset, out.size() - out_offset);
+      std::copy_n(std::span(buffer).subspan(buffer_offset).begin(), readable_num_bytes, out.subspan(out_offset).begin());
+
+      buffer_offset += readable_num_bytes;
+      out_offset += readable_num_bytes;
+    }
+  }
+
+  // Reads next `sizeof(T)` -bytes and interprets them as a little-endian unsigned integer.
+  template<typename T>
+  forceinline T read_le()
+  {
+    static_assert(std::endian::native == std::endian::little);
+
+    T value = 0;
+    if ((BUFFER_BYTE_LEN - buffer_offset) >= sizeof(T)) [[likely]] {
+      std::memcpy(&value, std::span(buffer).subspan(buffer_offset).data(), sizeof(T));
+      buffer_offset += sizeof(T);
+    } else {
+      std::array<uint8_t, sizeof(T)> bytes{};
+      read_across_refills(bytes);
+      std::memcpy(&value, bytes.data(), sizeof(T));
+    }
+
+    return value;
+  }
+
+public:
+  // Creates a reader over output of `xof`, which must already be finalized.
+  forceinline explicit xof_reader_t(xof_t& xof_to_read)
+    : xof(xof_to_read)
+  {
+  }
+
+  // Fills `out` with next `out.size()` -bytes of XOF output.
+  forceinline void read(std::span<uint8_t> out)
+  {
+    if ((BUFFER_BYTE_LEN - buffer_offset) >= out.size()) [[likely]] {
+      std::copy_n(std::span(buffer).subspan(buffer_offset).begin(), out.size(), out.begin());
+      buffer_offset += out.size();
+      return;
+    }
+
+    read_across_refills(out);
+  }
+
+  // Returns next byte of XOF output.
+  forceinline uint8_t read_u8() { return read_le<uint8_t>(); }
+
+  // Returns next 2 -bytes of XOF output, interpreted as a little-endian 16 -bit unsigned integer.
+  forceinline uint16_t read_u16() { return read_le<uint16_t>(); }
+
+  // Returns next 4 -bytes of XOF output, interpreted as a little-endian 32 -bit unsigned integer.
+  forceinline uint32_t read_u32() { return read_le<uint32_t>(); }
+};
+
+}
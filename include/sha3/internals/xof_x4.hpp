@@ -0,0 +1,145 @@
+#pragma once
+#include "sha3/internals/force_inline.hpp"
+#include "sha3/internals/keccak.hpp"
+#include "sha3/internals/keccak_x4.hpp"
+#include "sha3/internals/sponge.hpp"
+#include "sha3/internals/state_batch.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+// Four independent XOF instances, sharing lanes of 4-way multi-buffer Keccak-p[1600] permutation
+namespace sponge {
+
+/**
+ * Four independent instances of a Keccak[c] based XOF, kept in a `keccak::state_batch`, s.t. each permutation of all four of them is a single call to
+ * `keccak::permute_x4`. Meant for expanding matrices and vectors of lattice based schemes, where each entry comes out of its own XOF instance, seeded
+ * with a short seed and indices, and output is squeezed one block at a time. Output of each instance is bit-identical to that of a scalar XOF, absorbing
+ * same message.
+ *
+ * Four messages of equal length, given to `absorb`, are absorbed in lockstep, which is the common case. Messages of unequal length are absorbed on the
+ * scalar path, one instance after another, which is correct, but slow, if they span many blocks.
+ */
+template<uint8_t domain_separator, size_t ds_bit_len, size_t num_bits_in_rate, size_t num_rounds>
+  requires(check_domain_separator(ds_bit_len))
+struct xof_x4_t
+{
+public:
+  // # -of independent XOF instances.
+  static constexpr size_t INSTANCE_CNT = keccak::X4_STATE_CNT;
+
+  // Byte length of a block, squeezed by `squeezeblocks`, out of each instance.
+  static constexpr size_t BLOCK_BYTE_LEN = num_bits_in_rate / std::numeric_limits<uint8_t>::digits;
+
+private:
+  keccak::state_batch<INSTANCE_CNT> states{};
+  std::array<size_t, INSTANCE_CNT> offsets{};
+  alignas(4) bool finalized = false; // All message bytes absorbed?
+
+public:
+  forceinline constexpr xof_x4_t() = default;
+
+  /**
+   * Absorbs `msg_i` into i-th instance. Can be called any number of times, until `finalize` is called, after which it doesn't do anything. Instances stay
+   * in lockstep, as long as all four messages, across calls, are of equal length.
+   */
+  forceinline void absorb(std::span<const uint8_t> msg0, std::span<const uint8_t> msg1, std::span<const uint8_t> msg2, std::span<const uint8_t> msg3)
+  {
+    if (finalized) {
+      return;
+    }
+
+    const std::array<std::span<const uint8_t>, INSTANCE_CNT> msgs{ msg0, msg1, msg2, msg3 };
+
+    const bool same_msg_len = std::ranges::all_of(msgs, [&](const auto msg) { return msg.size() == msg0.size(); });
+    const bool same_offset = std::ranges::all_of(offsets, [&](const auto offset) { return offset == offsets[0]; });
+
+    if (!same_msg_len || !same_offset) {
+      std::array<uint64_t, keccak::LANE_CNT> state{};
+
+      for (size_t j = 0; j < INSTANCE_CNT; j++) {
+        states.load(j, state);
+        sponge::absorb<num_bits_in_rate, num_rounds>(state, offsets[j], msgs[j]);
+        states.store(j, state);
+      }
+
+      return;
+    }
+
+    size_t offset = offsets[0];
+    size_t msg_offset = 0;
+
+    while (msg_offset < msg0.size()) {
+      const size_t absorbable_num_bytes = std::min(BLOCK_BYTE_LEN - offset, msg0.size() - msg_offset);
+
+      for (size_t j = 0; j < INSTANCE_CNT; j++) {
+        states.absorb_bytes(j, offset, msgs[j].subspan(msg_offset, absorbable_num_bytes));
+      }
+
+      offset += absorbable_num_bytes;
+      msg_offset += absorbable_num_bytes;
+
+      if (offset == BLOCK_BYTE_LEN) {
+        states.template permute<num_rounds>();
+        offset = 0;
+      }
+    }
+
+    offsets.fill(offset);
+  }
+
+  // Pads message absorbed into each instance and permutes all of them, making them ready for squeezing. Calling it again doesn't do anything.
+  forceinline void finalize()
+  {
+    if (finalized) {
+      return;
+    }
+
+    std::array<uint64_t, keccak::LANE_CNT> state{};
+
+    for (size_t j = 0; j < INSTANCE_CNT; j++) {
+      states.load(j, state);
+      pad<domain_separator, ds_bit_len, num_bits_in_rate>(state, offsets[j]);
+      states.store(j, state);
+    }
+
+    states.template permute<num_rounds>();
+
+    offsets.fill(0);
+    finalized = true;
+  }
+
+  /**
+   * Squeezes `nblocks` blocks, each of `BLOCK_BYTE_LEN` -bytes, out of each instance, s.t. output of i-th instance is written to first
+   * `nblocks * BLOCK_BYTE_LEN` -bytes of `out_i`, which must be at least that long. Only does something after `finalize` is called.
+   */
+  forceinline void squeezeblocks(std::span<uint8_t> out0, std::span<uint8_t> out1, std::span<uint8_t> out2, std::span<uint8_t> out3, const size_t nblocks)
+  {
+    if (!finalized) {
+      return;
+    }
+
+    const std::array<std::span<uint8_t>, INSTANCE_CNT> outs{ out0, out1, out2, out3 };
+
+    for (size_t block = 0; block < nblocks; block++) {
+      for (size_t j = 0; j < INSTANCE_CNT; j++) {
+        states.squeeze_bytes(j, 0, outs[j].subspan(block * BLOCK_BYTE_LEN, BLOCK_BYTE_LEN));
+      }
+
+      states.template permute<num_rounds>();
+    }
+  }
+
+  // Resets all four instances, s.t. they can be used for another `absorb() -> finalize() -> squeezeblocks()` cycle.
+  forceinline constexpr void reset()
+  {
+    states.reset();
+    offsets.fill(0);
+    finalized = false;
+  }
+};
+
+}
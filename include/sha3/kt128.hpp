@@ -0,0 +1,54 @@
+#pragma once
+#include "sha3/internals/kangarootwelve.hpp"
+#include "sha3/internals/kangarootwelve_stream.hpp"
+#include "sha3/internals/thread_pool.hpp"
+#include "sha3/turboshake128.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// KangarooTwelve ( KT128 ) eXtendable Output Function : tree hashing mode on top of TurboSHAKE128
+namespace kt128 {
+
+// KT128 offers at max 128-bits of security.
+static constexpr size_t TARGET_BIT_SECURITY_LEVEL = turboshake128::TARGET_BIT_SECURITY_LEVEL;
+
+// Byte length of chunks, input is split into, for hashing them in parallel.
+static constexpr size_t CHUNK_BYTE_LEN = kangarootwelve::CHUNK_BYTE_LEN;
+
+// Byte length of chaining value of each leaf.
+static constexpr size_t CV_BYTE_LEN = 32;
+
+// Pool of threads, leaves of large inputs can be spread across.
+using thread_pool_t = sha3_utils::thread_pool_t;
+
+/**
+ * One-shot KT128, writing `out.size()` -bytes of output for message `msg` and customization string `customization`, which can be empty. Output is a prefix
+ * of any longer output, for same message and customization string.
+ *
+ * Inputs longer than `CHUNK_BYTE_LEN` -bytes are hashed as a tree of 8 KiB leaves, which are hashed four or eight at a time, in lanes of multi-buffer
+ * Keccak-p[1600, 12] permutation.
+ *
+ * See KT128 definition in section 3 of RFC 9861 https://datatracker.ietf.org/doc/rfc9861.
+ */
+static inline void
+hash(std::span<const uint8_t> msg, std::span<const uint8_t> customization, std::span<uint8_t> out)
+{
+  kangarootwelve::hash<turboshake128::turboshake128_t, turboshake128::RATE, CV_BYTE_LEN>(msg, customization, out, nullptr);
+}
+
+// Same as above, but leaves of large inputs are also spread across threads of `pool`, which can be reused across calls.
+static inline void
+hash(std::span<const uint8_t> msg, std::span<const uint8_t> customization, std::span<uint8_t> out, thread_pool_t& pool)
+{
+  kangarootwelve::hash<turboshake128::turboshake128_t, turboshake128::RATE, CV_BYTE_LEN>(msg, customization, out, &pool);
+}
+
+/**
+ * Incremental KT128, for messages of unknown length, say arriving over a pipe or socket, offering `absorb() -> finalize(customization) -> squeeze()`
+ * cycle. Full 8 KiB leaves are handed, 128 KiB at a time, to workers of the thread pool, given to the constructor, while rest of the message is still
+ * arriving, and only a bounded number of them is kept in memory. See `kangarootwelve::stream_t`.
+ */
+using kt128_t = kangarootwelve::stream_t<turboshake128::turboshake128_t, turboshake128::RATE, CV_BYTE_LEN>;
+
+}
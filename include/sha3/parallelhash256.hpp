@@ -0,0 +1,61 @@
+#pragma once
+#include "sha3/cshake256.hpp"
+#include "sha3/internals/parallelhash.hpp"
+#include "sha3/internals/thread_pool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// ParallelHash256 and ParallelHashXOF256 : parallelizable hashing of long messages, on top of cSHAKE256
+namespace parallelhash256 {
+
+// ParallelHash256 offers at max 256-bits of security.
+static constexpr size_t TARGET_BIT_SECURITY_LEVEL = cshake256::TARGET_BIT_SECURITY_LEVEL;
+
+// Byte length of chaining value of each block, which is cSHAKE256 output of 512 -bits.
+static constexpr size_t CV_BYTE_LEN = 64;
+
+// Pool of threads, blocks of large inputs can be spread across.
+using thread_pool_t = sha3_utils::thread_pool_t;
+
+/**
+ * One-shot ParallelHash256, writing `out.size()` -bytes of output for message `msg`, split into blocks of `block_len` ( > 0 ) -bytes, and customization
+ * string `customization`, which can be empty. Requested output length is bound into the output, so outputs of different length are unrelated.
+ *
+ * Blocks are hashed four or eight at a time, in lanes of multi-buffer Keccak-p[1600, 24] permutation. Output depends on `block_len`, so it must be agreed
+ * upon by both parties, as part of the protocol. Nothing is written, when `block_len` is 0.
+ *
+ * See ParallelHash definition in section 6 of SP 800-185 https://doi.org/10.6028/NIST.SP.800-185.
+ */
+static inline void
+hash(std::span<const uint8_t> msg, const size_t block_len, std::span<const uint8_t> customization, std::span<uint8_t> out)
+{
+  parallelhash::hash<cshake256::RATE, CV_BYTE_LEN>(msg, block_len, customization, out, false, nullptr);
+}
+
+// Same as above, but blocks of large inputs are also spread across threads of `pool`, which can be reused across calls.
+static inline void
+hash(std::span<const uint8_t> msg, const size_t block_len, std::span<const uint8_t> customization, std::span<uint8_t> out, thread_pool_t& pool)
+{
+  parallelhash::hash<cshake256::RATE, CV_BYTE_LEN>(msg, block_len, customization, out, false, &pool);
+}
+
+/**
+ * One-shot ParallelHashXOF256, same as `hash`, but output is a prefix of any longer output, for same message, block length and customization string.
+ *
+ * See ParallelHashXOF definition in section 6.3.1 of SP 800-185 https://doi.org/10.6028/NIST.SP.800-185.
+ */
+static inline void
+xof(std::span<const uint8_t> msg, const size_t block_len, std::span<const uint8_t> customization, std::span<uint8_t> out)
+{
+  parallelhash::hash<cshake256::RATE, CV_BYTE_LEN>(msg, block_len, customization, out, true, nullptr);
+}
+
+// Same as above, but blocks of large inputs are also spread across threads of `pool`, which can be reused across calls.
+static inline void
+xof(std::span<const uint8_t> msg, const size_t block_len, std::span<const uint8_t> customization, std::span<uint8_t> out, thread_pool_t& pool)
+{
+  parallelhash::hash<cshake256::RATE, CV_BYTE_LEN>(msg, block_len, customization, out, true, &pool);
+}
+
+}
@@ -1,8 +1,14 @@
 #pragma once
+#include "sha3/internals/job_manager.hpp"
 #include "sha3/internals/sponge.hpp"
+#include "sha3/internals/sponge_many.hpp"
+#include <algorithm>
+#include <array>
 #include <bit>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <span>
 
 // SHA3-512 Hash Function : Keccak[1024](M || 01, 512)
 namespace sha3_512 {
@@ -61,6 +67,45 @@ public:
     return md;
   }
 
+  /**
+   * Same as above, for a message whose length `N` is known at compile-time e.g. a 32 -byte or 64 -byte Merkle tree node. Position of padding bits is a
+   * compile-time constant, so there is no offset bookkeeping and, when `N` is less than `RATE/ 8` -bytes, exactly one permutation, see
+   * `sponge::hash_fixed_len`.
+   */
+  template<size_t N>
+  forceinline static constexpr std::array<uint8_t, DIGEST_LEN> hash(std::span<const uint8_t, N> msg)
+    requires(N != std::dynamic_extent)
+  {
+    std::array<uint8_t, DIGEST_LEN> md{ 0 };
+    sponge::hash_fixed_len<DOM_SEP, DOM_SEP_BW, RATE, NUM_KECCAK_ROUNDS>(msg, std::span(md));
+
+    return md;
+  }
+
+  /**
+   * One-shot hashes many independent messages, writing digest of `msgs[i]` to `out[i]`, for each i < min(`msgs.size()`, `out.size()`). Messages of similar
+   * length are hashed together, in lanes of multi-buffer Keccak-p[1600] permutation, see `sponge::hash_many`, which beats calling `hash` in a loop.
+   */
+  static void hash_many(std::span<const std::span<const uint8_t>> msgs, std::span<std::array<uint8_t, DIGEST_LEN>> out)
+  {
+    const size_t msg_cnt = std::min(msgs.size(), out.size());
+
+    sponge::hash_many<DOM_SEP, DOM_SEP_BW, RATE, NUM_KECCAK_ROUNDS>(
+      msg_cnt, [&](const size_t i) { return msgs[i]; }, [&](const size_t i) { return std::span<uint8_t>(out[i]); });
+  }
+
+  /**
+   * Same as above, but i-th message is the `record_len` -bytes record, starting at byte offset `i * stride` of `records` e.g. a column of keys, stored in a
+   * contiguous buffer, which doesn't need a span per record. As many records, as fit in `records`, are hashed, capped at `out.size()`.
+   */
+  static void hash_many(std::span<const uint8_t> records, const size_t record_len, const size_t stride, std::span<std::array<uint8_t, DIGEST_LEN>> out)
+  {
+    const size_t msg_cnt = sponge::strided_record_cnt(records, record_len, stride, out.size());
+
+    sponge::hash_many<DOM_SEP, DOM_SEP_BW, RATE, NUM_KECCAK_ROUNDS>(
+      msg_cnt, [&](const size_t i) { return records.subspan(i * stride, record_len); }, [&](const size_t i) { return std::span<uint8_t>(out[i]); });
+  }
+
   /*
    * Given N (>=0) -bytes message as input, this routine can be invoked arbitrary many times ( until the sponge is
    * finalized ), each time absorbing arbitrary many message bytes into RATE portion of the sponge.
@@ -112,4 +157,10 @@ public:
   }
 };
 
+// Multi-buffer job manager, hashing a stream of messages of unequal length, in lanes of 4 -way multi-buffer permutation, see `sponge::job_manager_t`.
+using job_manager_t = sponge::job_manager_t<DOM_SEP, DOM_SEP_BW, RATE, NUM_KECCAK_ROUNDS, keccak::X4_STATE_CNT>;
+
+// Same as `job_manager_t`, but in lanes of 8 -way multi-buffer permutation.
+using job_manager_x8_t = sponge::job_manager_t<DOM_SEP, DOM_SEP_BW, RATE, NUM_KECCAK_ROUNDS, keccak::X8_STATE_CNT>;
+
 }
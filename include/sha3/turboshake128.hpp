@@ -1,7 +1,13 @@
 #pragma once
+#include "sha3/internals/hash_chain.hpp"
+#include "sha3/internals/job_manager.hpp"
 #include "sha3/internals/keccak.hpp"
 #include "sha3/internals/sponge.hpp"
+#include "sha3/internals/sponge_many.hpp"
+#include "sha3/internals/uniform_sampler.hpp"
+#include "sha3/internals/xof_reader.hpp"
 #include <algorithm>
+#include <array>
 #include <bit>
 #include <cstddef>
 #include <cstdint>
@@ -40,6 +46,43 @@ public:
   forceinline constexpr turboshake128_t() = default;
   [[nodiscard]] forceinline constexpr size_t squeezable_num_bytes() const { return squeezable; }
 
+  /**
+   * One-shot hashes many independent messages, squeezing `out_len` -bytes out of each of them, s.t. output of `msgs[i]` is written to
+   * `out[i * out_len : (i + 1) * out_len]`, for each i < min(`msgs.size()`, `out.size() / out_len`). Messages of similar length are hashed together, in
+   * lanes of multi-buffer Keccak-p[1600] permutation, see `sponge::hash_many`. Each message is finalized using domain separator `dom_sep`.
+   */
+  template<uint8_t dom_sep = 0x1f>
+  static void hash_many(std::span<const std::span<const uint8_t>> msgs, std::span<uint8_t> out, const size_t out_len)
+    requires((dom_sep >= 0x01) && (dom_sep <= 0x7f))
+  {
+    if (out_len == 0) {
+      return;
+    }
+
+    const size_t msg_cnt = std::min(msgs.size(), out.size() / out_len);
+
+    sponge::hash_many<dom_sep, std::bit_width(dom_sep) - 1, RATE, NUM_KECCAK_ROUNDS>(
+      msg_cnt, [&](const size_t i) { return msgs[i]; }, [&](const size_t i) { return out.subspan(i * out_len, out_len); });
+  }
+
+  /**
+   * Same as above, but i-th message is the `record_len` -bytes record, starting at byte offset `i * stride` of `records` e.g. a column of keys, stored in a
+   * contiguous buffer, which doesn't need a span per record. As many records, as fit in `records`, are hashed, capped at `out.size() / out_len`.
+   */
+  template<uint8_t dom_sep = 0x1f>
+  static void hash_many(std::span<const uint8_t> records, const size_t record_len, const size_t stride, std::span<uint8_t> out, const size_t out_len)
+    requires((dom_sep >= 0x01) && (dom_sep <= 0x7f))
+  {
+    if (out_len == 0) {
+      return;
+    }
+
+    const size_t msg_cnt = sponge::strided_record_cnt(records, record_len, stride, out.size() / out_len);
+
+    sponge::hash_many<dom_sep, std::bit_width(dom_sep) - 1, RATE, NUM_KECCAK_ROUNDS>(
+      msg_cnt, [&](const size_t i) { return records.subspan(i * stride, record_len); }, [&](const size_t i) { return out.subspan(i * out_len, out_len); });
+  }
+
   /**
    * Given N -many bytes input message, this routine consumes those into keccak[256] sponge state.
    *
@@ -114,4 +157,36 @@ public:
   }
 };
 
+// Multi-buffer job manager, hashing a stream of messages of unequal length, in lanes of 4 -way multi-buffer permutation, see `sponge::job_manager_t`. Each
+// message is finalized using domain separator `dom_sep`.
+template<uint8_t dom_sep = 0x1f>
+using job_manager_t = sponge::job_manager_t<dom_sep, std::bit_width(dom_sep) - 1, RATE, NUM_KECCAK_ROUNDS, keccak::X4_STATE_CNT>;
+
+// Same as `job_manager_t`, but in lanes of 8 -way multi-buffer permutation.
+template<uint8_t dom_sep = 0x1f>
+using job_manager_x8_t = sponge::job_manager_t<dom_sep, std::bit_width(dom_sep) - 1, RATE, NUM_KECCAK_ROUNDS, keccak::X8_STATE_CNT>;
+
+// Buffered reader over output of a finalized TurboSHAKE128 instance, squeezing `block_cnt` blocks at a time, see `sponge::xof_reader_t`.
+template<size_t block_cnt = 1>
+using reader_t = sponge::xof_reader_t<turboshake128_t, RATE, block_cnt>;
+
+// Fills `out` with values uniform in [0, q), by rejection sampling output of finalized TurboSHAKE128 instance `xof`, see `sponge::sample_uniform`.
+template<uint32_t q, typename T>
+static inline void
+sample_uniform(turboshake128_t& xof, std::span<T> out)
+  requires(sponge::sampleable<q, T>)
+{
+  sponge::sample_uniform<q, RATE>(xof, out);
+}
+
+// Advances each of many independent hash chains, over `value_len` -byte values, by `steps[i]` steps, in place, where each step is x = TurboSHAKE128(x, dom_sep,
+// `value_len`). Chains are spread across lanes of multi-buffer permutation, see `sponge::advance_chains`.
+template<uint8_t dom_sep = 0x1f, size_t value_len>
+static inline void
+advance_chains(std::span<std::array<uint8_t, value_len>> values, std::span<const size_t> steps)
+  requires((dom_sep >= 0x01) && (dom_sep <= 0x7f))
+{
+  sponge::advance_chains<dom_sep, std::bit_width(dom_sep) - 1, RATE, NUM_KECCAK_ROUNDS, value_len>(values, steps);
+}
+
 }
@@ -0,0 +1,90 @@
+#include "sha3/cshake128.hpp"
+#include "sha3/shake128.hpp"
+#include "test_utils.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+std::vector<uint8_t>
+to_bytes(std::string_view str)
+{
+  return { str.begin(), str.end() };
+}
+
+template<size_t OLEN>
+std::array<uint8_t, OLEN>
+compute_cshake128_output(const std::vector<uint8_t>& msg, const std::vector<uint8_t>& function_name, const std::vector<uint8_t>& customization)
+{
+  std::array<uint8_t, OLEN> out_bytes{};
+
+  cshake128::cshake128_t hasher(function_name, customization);
+  hasher.absorb(msg);
+  hasher.finalize();
+  hasher.squeeze(out_bytes);
+
+  return out_bytes;
+}
+
+}
+
+// Ensure that cSHAKE128 implementation is conformant with NIST SP 800-185, by using sample values published at
+// https://csrc.nist.gov/projects/cryptographic-standards-and-guidelines/example-values.
+TEST(Sha3XOF, CSHAKE128KnownAnswerTests)
+{
+  std::vector<uint8_t> msg(200);
+  std::iota(msg.begin(), msg.end(), 0);
+
+  const std::vector<uint8_t> short_msg(msg.begin(), msg.begin() + 4);
+
+  // clang-format off
+  EXPECT_EQ((compute_cshake128_output<32>(short_msg, {}, to_bytes("Email Signature"))), sha3_test_utils::from_hex<32>("c1c36925b6409a04f1b504fcbca9d82b4017277cb5ed2b2065fc1d3814d5aaf5"));
+  EXPECT_EQ((compute_cshake128_output<32>(msg, {}, to_bytes("Email Signature"))), sha3_test_utils::from_hex<32>("c5221d50e4f822d96a2e8881a961420f294b7b24fe3d2094baed2c6524cc166b"));
+  EXPECT_EQ((compute_cshake128_output<32>(sha3_test_utils::ptn(4), to_bytes("My Function"), {})), sha3_test_utils::from_hex<32>("44ee668b67b3ee6b6304278491c7f70823ed05eea5186d666b25364d68fbfef0"));
+  // clang-format on
+}
+
+// Ensure that cSHAKE128, with empty function name and customization string, is same as SHAKE128, and that it can be reset, keeping its customization.
+TEST(Sha3XOF, CSHAKE128EmptyCustomizationIsSHAKE128AndResetKeepsCustomization)
+{
+  constexpr size_t OLEN = 300;
+
+  for (size_t mlen = 0; mlen < 600; mlen += 37) {
+    std::vector<uint8_t> msg(mlen);
+    sha3_test_utils::random_data<uint8_t>(msg);
+
+    std::vector<uint8_t> expected(OLEN);
+    std::vector<uint8_t> computed(OLEN);
+
+    shake128::shake128_t shake;
+    shake.absorb(msg);
+    shake.finalize();
+    shake.squeeze(expected);
+
+    cshake128::cshake128_t hasher;
+    hasher.absorb(msg);
+    hasher.finalize();
+    hasher.squeeze(computed);
+
+    EXPECT_EQ(computed, expected);
+
+    cshake128::cshake128_t customized(to_bytes("fn"), msg);
+    customized.absorb(msg);
+    customized.finalize();
+    customized.squeeze(expected);
+
+    customized.reset();
+    customized.absorb(msg);
+    customized.finalize();
+    customized.squeeze(std::span(computed).first(OLEN / 3));
+    customized.squeeze(std::span(computed).subspan(OLEN / 3));
+
+    EXPECT_EQ(computed, expected);
+  }
+}
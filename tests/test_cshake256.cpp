@@ -0,0 +1,89 @@
+#include "sha3/cshake256.hpp"
+#include "sha3/shake256.hpp"
+#include "test_utils.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+std::vector<uint8_t>
+to_bytes(std::string_view str)
+{
+  return { str.begin(), str.end() };
+}
+
+template<size_t OLEN>
+std::array<uint8_t, OLEN>
+compute_cshake256_output(const std::vector<uint8_t>& msg, const std::vector<uint8_t>& function_name, const std::vector<uint8_t>& customization)
+{
+  std::array<uint8_t, OLEN> out_bytes{};
+
+  cshake256::cshake256_t hasher(function_name, customization);
+  hasher.absorb(msg);
+  hasher.finalize();
+  hasher.squeeze(out_bytes);
+
+  return out_bytes;
+}
+
+}
+
+// Ensure that cSHAKE256 implementation is conformant with NIST SP 800-185, by using sample values published at
+// https://csrc.nist.gov/projects/cryptographic-standards-and-guidelines/example-values.
+TEST(Sha3XOF, CSHAKE256KnownAnswerTests)
+{
+  std::vector<uint8_t> msg(200);
+  std::iota(msg.begin(), msg.end(), 0);
+
+  const std::vector<uint8_t> short_msg(msg.begin(), msg.begin() + 4);
+
+  // clang-format off
+  EXPECT_EQ((compute_cshake256_output<64>(short_msg, {}, to_bytes("Email Signature"))), sha3_test_utils::from_hex<64>("d008828e2b80ac9d2218ffee1d070c48b8e4c87bff32c9699d5b6896eee0edd164020e2be0560858d9c00c037e34a96937c561a74c412bb4c746469527281c8c"));
+  EXPECT_EQ((compute_cshake256_output<64>(msg, {}, to_bytes("Email Signature"))), sha3_test_utils::from_hex<64>("07dc27b11e51fbac75bc7b3c1d983e8b4b85fb1defaf218912ac86430273091727f42b17ed1df63e8ec118f04b23633c1dfb1574c8fb55cb45da8e25afb092bb"));
+  // clang-format on
+}
+
+// Ensure that cSHAKE256, with empty function name and customization string, is same as SHAKE256, and that it can be reset, keeping its customization.
+TEST(Sha3XOF, CSHAKE256EmptyCustomizationIsSHAKE256AndResetKeepsCustomization)
+{
+  constexpr size_t OLEN = 300;
+
+  for (size_t mlen = 0; mlen < 600; mlen += 37) {
+    std::vector<uint8_t> msg(mlen);
+    sha3_test_utils::random_data<uint8_t>(msg);
+
+    std::vector<uint8_t> expected(OLEN);
+    std::vector<uint8_t> computed(OLEN);
+
+    shake256::shake256_t shake;
+    shake.absorb(msg);
+    shake.finalize();
+    shake.squeeze(expected);
+
+    cshake256::cshake256_t hasher;
+    hasher.absorb(msg);
+    hasher.finalize();
+    hasher.squeeze(computed);
+
+    EXPECT_EQ(computed, expected);
+
+    cshake256::cshake256_t customized(to_bytes("fn"), msg);
+    customized.absorb(msg);
+    customized.finalize();
+    customized.squeeze(expected);
+
+    customized.reset();
+    customized.absorb(msg);
+    customized.finalize();
+    customized.squeeze(std::span(computed).first(OLEN / 3));
+    customized.squeeze(std::span(computed).subspan(OLEN / 3));
+
+    EXPECT_EQ(computed, expected);
+  }
+}
@@ -0,0 +1,514 @@
+#include "sha3/internals/keccak.hpp"
+#include "sha3/internals/keccak_bit_interleaved.hpp"
+#include "sha3/internals/keccak_x2.hpp"
+#include "sha3/internals/keccak_x4.hpp"
+#include "sha3/internals/keccak_x8.hpp"
+#include "sha3/internals/state_batch.hpp"
+#include "sha3/internals/utils.hpp"
+#include "test_utils.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <span>
+
+namespace {
+
+// Permutes `state_cnt` random states using multi-buffer Keccak-p[1600] permutation and checks that result is same as permuting each of them separately.
+template<size_t state_cnt, size_t num_rounds>
+void
+test_keccak_permutation_multi_buffer()
+{
+  constexpr size_t ITERATION_CNT = 16;
+
+  std::array<uint64_t, keccak::LANE_CNT * state_cnt> states{};
+  sha3_test_utils::random_data<uint64_t>(states);
+
+  for (size_t iter = 0; iter < ITERATION_CNT; iter++) {
+    std::array<std::array<uint64_t, keccak::LANE_CNT>, state_cnt> expected{};
+    for (size_t j = 0; j < state_cnt; j++) {
+      for (size_t i = 0; i < keccak::LANE_CNT; i++) {
+        expected[j][i] = states[(i * state_cnt) + j];
+      }
+
+      keccak::permute<num_rounds>(expected[j]);
+    }
+
+    if constexpr (state_cnt == keccak::X2_STATE_CNT) {
+      keccak::permute_x2<num_rounds>(states);
+    } else if constexpr (state_cnt == keccak::X4_STATE_CNT) {
+      keccak::permute_x4<num_rounds>(states);
+    } else {
+      keccak::permute_x8<num_rounds>(states);
+    }
+
+    for (size_t j = 0; j < state_cnt; j++) {
+      for (size_t i = 0; i < keccak::LANE_CNT; i++) {
+        EXPECT_EQ(states[(i * state_cnt) + j], expected[j][i]);
+      }
+    }
+  }
+}
+
+// Eval 2-way interleaved scalar Keccak-p[1600] permutation on two zero initialized states, during compilation-time.
+template<size_t num_rounds>
+constexpr std::array<uint64_t, keccak::LANE_CNT * keccak::X2_STATE_CNT>
+eval_keccak_permutation_x2()
+{
+  std::array<uint64_t, keccak::LANE_CNT * keccak::X2_STATE_CNT> states{};
+  keccak::permute_x2<num_rounds>(states);
+
+  return states;
+}
+
+// Eval 4-way multi-buffer Keccak-p[1600] permutation on four zero initialized states, during compilation-time.
+template<size_t num_rounds>
+constexpr std::array<uint64_t, keccak::LANE_CNT * keccak::X4_STATE_CNT>
+eval_keccak_permutation_x4()
+{
+  std::array<uint64_t, keccak::LANE_CNT * keccak::X4_STATE_CNT> states{};
+  keccak::permute_x4<num_rounds>(states);
+
+  return states;
+}
+
+// Permutes a random state using requested variant of χ step mapping function and checks that result is same as the standard one.
+template<size_t num_rounds, keccak::chi_t chi>
+void
+test_keccak_permutation_chi_variant()
+{
+  constexpr size_t ITERATION_CNT = 16;
+
+  std::array<uint64_t, keccak::LANE_CNT> state{};
+  sha3_test_utils::random_data<uint64_t>(state);
+
+  for (size_t iter = 0; iter < ITERATION_CNT; iter++) {
+    auto expected = state;
+
+    keccak::permute<num_rounds, chi>(state);
+    keccak::permute_portable<num_rounds>(expected);
+
+    EXPECT_EQ(state, expected);
+  }
+}
+
+// Eval Keccak-p[1600] permutation on zero initialized state, using requested variant of χ step mapping function, during compilation-time.
+template<size_t num_rounds, keccak::chi_t chi>
+constexpr std::array<uint64_t, keccak::LANE_CNT>
+eval_keccak_permutation_chi_variant()
+{
+  std::array<uint64_t, keccak::LANE_CNT> state{};
+  keccak::permute<num_rounds, chi>(state);
+
+  return state;
+}
+
+
+// Permutes a random state using the bit-interleaved implementation and checks that result is same as the portable one.
+template<size_t num_rounds>
+void
+test_keccak_permutation_bit_interleaved()
+{
+  constexpr size_t ITERATION_CNT = 16;
+
+  std::array<uint64_t, keccak::LANE_CNT> state{};
+  sha3_test_utils::random_data<uint64_t>(state);
+
+  for (size_t iter = 0; iter < ITERATION_CNT; iter++) {
+    auto expected = state;
+
+    keccak::bit_interleaved::permute<num_rounds>(state);
+    keccak::permute_portable<num_rounds>(expected);
+
+    EXPECT_EQ(state, expected);
+  }
+}
+
+// Eval bit-interleaved Keccak-p[1600] permutation on zero initialized state, during compilation-time.
+template<size_t num_rounds>
+constexpr std::array<uint64_t, keccak::LANE_CNT>
+eval_keccak_permutation_bit_interleaved()
+{
+  std::array<uint64_t, keccak::LANE_CNT> state{};
+  keccak::bit_interleaved::permute<num_rounds>(state);
+
+  return state;
+}
+
+// Permutes a random state with the round loop unrolled `unroll` -times and checks that result is same as the default unroll depth.
+template<size_t num_rounds, keccak::chi_t chi, size_t unroll>
+void
+test_keccak_permutation_unroll_depth()
+{
+  constexpr size_t ITERATION_CNT = 16;
+
+  std::array<uint64_t, keccak::LANE_CNT> state{};
+  sha3_test_utils::random_data<uint64_t>(state);
+
+  for (size_t iter = 0; iter < ITERATION_CNT; iter++) {
+    auto expected = state;
+
+    keccak::permute_portable<num_rounds, chi, unroll>(state);
+    keccak::permute_portable<num_rounds>(expected);
+
+    EXPECT_EQ(state, expected);
+  }
+}
+
+// Eval Keccak-p[1600] permutation on zero initialized state, with the round loop unrolled `unroll` -times, during compilation-time.
+template<size_t num_rounds, size_t unroll>
+constexpr std::array<uint64_t, keccak::LANE_CNT>
+eval_keccak_permutation_unroll_depth()
+{
+  std::array<uint64_t, keccak::LANE_CNT> state{};
+  keccak::permute_portable<num_rounds, keccak::chi_t::standard, unroll>(state);
+
+  return state;
+}
+
+/**
+ * Absorbs bytes, at random offsets, into and squeezes bytes, at random offsets, out of individual columns of a batch of `state_cnt` Keccak-p[1600] states,
+ * interleaved with permuting the whole batch, and checks that each column behaves same as a standalone state.
+ */
+template<size_t state_cnt>
+void
+test_keccak_state_batch()
+{
+  constexpr size_t ITERATION_CNT = 64;
+  constexpr size_t RATE = 1088;
+
+  keccak::state_batch<state_cnt> batch{};
+  std::array<std::array<uint8_t, keccak::STATE_BYTE_LEN>, state_cnt> expected{};
+
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(batch.data().data()) % 64, 0U);
+
+  std::mt19937_64 gen(state_cnt);
+  std::uniform_int_distribution<size_t> dis(0, keccak::STATE_BYTE_LEN);
+
+  std::array<uint8_t, keccak::STATE_BYTE_LEN> bytes{};
+  std::array<uint8_t, keccak::STATE_BYTE_LEN> squeezed{};
+
+  for (size_t iter = 0; iter < ITERATION_CNT; iter++) {
+    for (size_t j = 0; j < state_cnt; j++) {
+      const size_t offset = dis(gen);
+      const size_t len = dis(gen) % (keccak::STATE_BYTE_LEN - offset + 1);
+
+      sha3_test_utils::random_data<uint8_t>(bytes);
+      batch.absorb_bytes(j, offset, std::span(bytes).first(len));
+
+      for (size_t k = 0; k < len; k++) {
+        expected[j][offset + k] ^= bytes[k];
+      }
+    }
+
+    const size_t col = iter % state_cnt;
+    batch.template absorb_block<RATE>(col, std::span(bytes).template first<RATE / 8>());
+    for (size_t k = 0; k < (RATE / 8); k++) {
+      expected[col][k] ^= bytes[k];
+    }
+
+    batch.template permute<24>();
+
+    std::array<uint64_t, keccak::LANE_CNT> state{};
+    for (size_t j = 0; j < state_cnt; j++) {
+      for (size_t i = 0; i < keccak::LANE_CNT; i++) {
+        state[i] = sha3_utils::le_bytes_to_u64(std::span(expected[j]).subspan(i * 8).template first<8>());
+      }
+
+      keccak::permute<24>(state);
+
+      for (size_t i = 0; i < keccak::LANE_CNT; i++) {
+        sha3_utils::u64_to_le_bytes(state[i], std::span(expected[j]).subspan(i * 8).template first<8>());
+      }
+
+      const size_t offset = dis(gen);
+      const size_t len = dis(gen) % (keccak::STATE_BYTE_LEN - offset + 1);
+
+      batch.squeeze_bytes(j, offset, std::span(squeezed).first(len));
+      EXPECT_TRUE(std::ranges::equal(std::span(squeezed).first(len), std::span(expected[j]).subspan(offset, len)));
+
+      std::array<uint64_t, keccak::LANE_CNT> loaded{};
+      batch.load(j, loaded);
+      EXPECT_EQ(loaded, state);
+    }
+  }
+}
+
+}
+
+// Ensure that Keccak-p[1600] permutation, dispatched to the best backend available on this CPU, agrees with the portable scalar one.
+TEST(KeccakPermutation, KeccakP1600DispatchedMatchesPortable)
+{
+  constexpr size_t ITERATION_CNT = 16;
+
+  std::array<uint64_t, keccak::LANE_CNT> state12{};
+  std::array<uint64_t, keccak::LANE_CNT> state24{};
+  sha3_test_utils::random_data<uint64_t>(state12);
+  sha3_test_utils::random_data<uint64_t>(state24);
+
+  for (size_t iter = 0; iter < ITERATION_CNT; iter++) {
+    auto expected12 = state12;
+    auto expected24 = state24;
+
+    keccak::permute<12>(state12);
+    keccak::permute_portable<12>(expected12);
+    keccak::permute<24>(state24);
+    keccak::permute_portable<24>(expected24);
+
+    EXPECT_EQ(state12, expected12);
+    EXPECT_EQ(state24, expected24);
+  }
+}
+
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+// Ensure that single-state AVX2 Keccak-p[1600] permutation agrees with the portable scalar one. It's tested separately, as the dispatched permutation
+// prefers AVX-512, when available.
+TEST(KeccakPermutation, KeccakP1600AVX2MatchesPortable)
+{
+  if (!cpu_features::has_avx2()) {
+    GTEST_SKIP() << "AVX2 is not supported by this CPU";
+  }
+
+  constexpr size_t ITERATION_CNT = 16;
+
+  std::array<uint64_t, keccak::LANE_CNT> state12{};
+  std::array<uint64_t, keccak::LANE_CNT> state24{};
+  sha3_test_utils::random_data<uint64_t>(state12);
+  sha3_test_utils::random_data<uint64_t>(state24);
+
+  for (size_t iter = 0; iter < ITERATION_CNT; iter++) {
+    auto expected12 = state12;
+    auto expected24 = state24;
+
+    keccak::avx2::permute<12>(state12);
+    keccak::permute_portable<12>(expected12);
+    keccak::avx2::permute<24>(state24);
+    keccak::permute_portable<24>(expected24);
+
+    EXPECT_EQ(state12, expected12);
+    EXPECT_EQ(state24, expected24);
+  }
+}
+#endif
+
+#if defined(SHA3_HAS_AARCH64_SHA3_BACKEND)
+// Ensure that 2-way Keccak-p[1600] permutation, using ARMv8.2 SHA3 extension, agrees with the portable one. Build with an AArch64 cross-compiler and run under
+// `qemu-aarch64`, for testing it on x86-64 hosts.
+TEST(KeccakPermutation, KeccakP1600x2NeonSha3MatchesPortable)
+{
+  if (!cpu_features::has_sha3()) {
+    GTEST_SKIP() << "SHA3 extension is not supported by this CPU";
+  }
+
+  constexpr size_t ITERATION_CNT = 16;
+
+  std::array<uint64_t, keccak::LANE_CNT * keccak::X2_STATE_CNT> states12{};
+  std::array<uint64_t, keccak::LANE_CNT * keccak::X2_STATE_CNT> states24{};
+  sha3_test_utils::random_data<uint64_t>(states12);
+  sha3_test_utils::random_data<uint64_t>(states24);
+
+  for (size_t iter = 0; iter < ITERATION_CNT; iter++) {
+    auto expected12 = states12;
+    auto expected24 = states24;
+
+    keccak::neon_sha3::permute_x2<12>(states12);
+    keccak::permute_x2_portable<12>(expected12);
+    keccak::neon_sha3::permute_x2<24>(states24);
+    keccak::permute_x2_portable<24>(expected24);
+
+    EXPECT_EQ(states12, expected12);
+    EXPECT_EQ(states24, expected24);
+  }
+}
+#endif
+
+// Ensure that `andn` and lane-complementing variants of χ step mapping function agree with the standard one.
+TEST(KeccakPermutation, KeccakP1600x12ChiAndn)
+{
+  test_keccak_permutation_chi_variant<12, keccak::chi_t::andn>();
+}
+
+TEST(KeccakPermutation, KeccakP1600x24ChiAndn)
+{
+  test_keccak_permutation_chi_variant<24, keccak::chi_t::andn>();
+}
+
+TEST(KeccakPermutation, KeccakP1600x12ChiLaneComplementing)
+{
+  test_keccak_permutation_chi_variant<12, keccak::chi_t::lane_complementing>();
+}
+
+TEST(KeccakPermutation, KeccakP1600x24ChiLaneComplementing)
+{
+  test_keccak_permutation_chi_variant<24, keccak::chi_t::lane_complementing>();
+}
+
+// Ensure that lane-complementing variant of Keccak-f[1600] permutation is compile-time evaluable.
+TEST(KeccakPermutation, CompileTimeEvalKeccakP1600ChiLaneComplementing)
+{
+  constexpr auto state = eval_keccak_permutation_chi_variant<24, keccak::chi_t::lane_complementing>();
+
+  static_assert(state[0] == 0xf1258f7940e1dde7UL, "Must be able to compute Keccak-f[1600] permutation during compile-time !");
+  static_assert(state[24] == 0xeaf1ff7b5ceca249UL, "Must be able to compute Keccak-f[1600] permutation during compile-time !");
+}
+
+// Ensure that a lane, brought into bit-interleaved form, keeps its even bits in the lower half and odd bits in the upper half, and that it can be brought
+// back.
+TEST(KeccakPermutation, BitInterleavedLaneRoundTrip)
+{
+  std::array<uint64_t, 64> lanes{};
+  sha3_test_utils::random_data<uint64_t>(lanes);
+
+  for (const auto lane : lanes) {
+    const auto interleaved = keccak::bit_interleaved::to_bit_interleaved(lane);
+
+    for (size_t i = 0; i < 32; i++) {
+      EXPECT_EQ((interleaved.even >> i) & 1U, (lane >> (2 * i)) & 1U);
+      EXPECT_EQ((interleaved.odd >> i) & 1U, (lane >> ((2 * i) + 1)) & 1U);
+    }
+
+    EXPECT_EQ(keccak::bit_interleaved::from_bit_interleaved(interleaved), lane);
+  }
+}
+
+TEST(KeccakPermutation, KeccakP1600x12BitInterleaved)
+{
+  test_keccak_permutation_bit_interleaved<12>();
+}
+
+TEST(KeccakPermutation, KeccakP1600x24BitInterleaved)
+{
+  test_keccak_permutation_bit_interleaved<24>();
+}
+
+// Ensure that bit-interleaved Keccak-p[1600] permutation is compile-time evaluable. First lane of Keccak-f[1600] applied on zero state is 0xf1258f7940e1dde7.
+TEST(KeccakPermutation, CompileTimeEvalKeccakP1600BitInterleaved)
+{
+  constexpr auto state = eval_keccak_permutation_bit_interleaved<24>();
+
+  static_assert(state[0] == 0xf1258f7940e1dde7UL, "Must be able to compute Keccak-f[1600] permutation during compile-time !");
+  static_assert(state[24] == 0xeaf1ff7b5ceca249UL, "Must be able to compute Keccak-f[1600] permutation during compile-time !");
+}
+
+// Ensure that the round loop of portable Keccak-p[1600] permutation produces same result, for each supported unroll depth.
+TEST(KeccakPermutation, KeccakP1600x12UnrollDepth)
+{
+  test_keccak_permutation_unroll_depth<12, keccak::chi_t::standard, 1>();
+  test_keccak_permutation_unroll_depth<12, keccak::chi_t::standard, 2>();
+  test_keccak_permutation_unroll_depth<12, keccak::chi_t::standard, 4>();
+  test_keccak_permutation_unroll_depth<12, keccak::chi_t::standard, 24>();
+}
+
+TEST(KeccakPermutation, KeccakP1600x24UnrollDepth)
+{
+  test_keccak_permutation_unroll_depth<24, keccak::chi_t::standard, 1>();
+  test_keccak_permutation_unroll_depth<24, keccak::chi_t::standard, 2>();
+  test_keccak_permutation_unroll_depth<24, keccak::chi_t::standard, 4>();
+  test_keccak_permutation_unroll_depth<24, keccak::chi_t::standard, 24>();
+}
+
+#if defined(SHA3_HAS_X86_64_SIMD_BACKENDS)
+TEST(KeccakPermutation, KeccakP1600UnrollDepthChiAndn)
+{
+  if (!cpu_features::has_bmi()) {
+    GTEST_SKIP() << "BMI1 is not supported by this CPU";
+  }
+
+  test_keccak_permutation_unroll_depth<24, keccak::chi_t::andn, 1>();
+  test_keccak_permutation_unroll_depth<24, keccak::chi_t::andn, 2>();
+  test_keccak_permutation_unroll_depth<24, keccak::chi_t::andn, 24>();
+}
+#endif
+
+// Ensure that portable Keccak-f[1600] permutation is compile-time evaluable, for each supported unroll depth.
+TEST(KeccakPermutation, CompileTimeEvalKeccakP1600UnrollDepth)
+{
+  constexpr auto state1 = eval_keccak_permutation_unroll_depth<24, 1>();
+  constexpr auto state2 = eval_keccak_permutation_unroll_depth<24, 2>();
+  constexpr auto state24 = eval_keccak_permutation_unroll_depth<24, 24>();
+
+  static_assert(state1[0] == 0xf1258f7940e1dde7UL, "Must be able to compute Keccak-f[1600] permutation during compile-time !");
+  static_assert(state2 == state1, "Must be able to compute Keccak-f[1600] permutation during compile-time !");
+  static_assert(state24 == state1, "Must be able to compute Keccak-f[1600] permutation during compile-time !");
+}
+
+TEST(KeccakPermutation, KeccakP1600x12MultiBufferX2)
+{
+  test_keccak_permutation_multi_buffer<keccak::X2_STATE_CNT, 12>();
+}
+
+TEST(KeccakPermutation, KeccakP1600x24MultiBufferX2)
+{
+  test_keccak_permutation_multi_buffer<keccak::X2_STATE_CNT, 24>();
+}
+
+TEST(KeccakPermutation, KeccakP1600x12MultiBufferX4)
+{
+  test_keccak_permutation_multi_buffer<keccak::X4_STATE_CNT, 12>();
+}
+
+TEST(KeccakPermutation, KeccakP1600x24MultiBufferX4)
+{
+  test_keccak_permutation_multi_buffer<keccak::X4_STATE_CNT, 24>();
+}
+
+TEST(KeccakPermutation, KeccakP1600x12MultiBufferX8)
+{
+  test_keccak_permutation_multi_buffer<keccak::X8_STATE_CNT, 12>();
+}
+
+TEST(KeccakPermutation, KeccakP1600x24MultiBufferX8)
+{
+  test_keccak_permutation_multi_buffer<keccak::X8_STATE_CNT, 24>();
+}
+
+// Ensure that portable fallback of 8-way multi-buffer Keccak-p[1600] permutation, used on hosts without AVX-512, agrees with the dispatched one.
+TEST(KeccakPermutation, KeccakP1600MultiBufferX8PortableFallback)
+{
+  std::array<uint64_t, keccak::LANE_CNT * keccak::X8_STATE_CNT> states{};
+  sha3_test_utils::random_data<uint64_t>(states);
+
+  auto expected = states;
+
+  keccak::permute_x8<24>(states);
+  keccak::permute_x8_portable<24>(expected);
+
+  EXPECT_EQ(states, expected);
+}
+
+// Ensure that 2-way interleaved scalar Keccak-p[1600] permutation is compile-time evaluable. First lane of Keccak-f[1600] applied on zero state is
+// 0xf1258f7940e1dde7.
+TEST(KeccakPermutation, CompileTimeEvalKeccakP1600MultiBufferX2)
+{
+  constexpr auto states = eval_keccak_permutation_x2<24>();
+
+  static_assert(states[0] == 0xf1258f7940e1dde7UL, "Must be able to compute Keccak-f[1600] permutation during compile-time !");
+  static_assert(states[1] == 0xf1258f7940e1dde7UL, "Must be able to compute Keccak-f[1600] permutation during compile-time !");
+  static_assert(states[(24 * keccak::X2_STATE_CNT) + 1] == 0xeaf1ff7b5ceca249UL, "Must be able to compute Keccak-f[1600] permutation during compile-time !");
+}
+
+// Ensure that 4-way multi-buffer Keccak-p[1600] permutation is compile-time evaluable. First lane of Keccak-f[1600] applied on zero state is 0xf1258f7940e1dde7.
+TEST(KeccakPermutation, CompileTimeEvalKeccakP1600MultiBufferX4)
+{
+  constexpr auto states = eval_keccak_permutation_x4<24>();
+
+  static_assert(states[0] == 0xf1258f7940e1dde7UL, "Must be able to compute Keccak-f[1600] permutation during compile-time !");
+  static_assert(states[3] == 0xf1258f7940e1dde7UL, "Must be able to compute Keccak-f[1600] permutation during compile-time !");
+  static_assert(states[(24 * keccak::X4_STATE_CNT) + 2] == 0xeaf1ff7b5ceca249UL, "Must be able to compute Keccak-f[1600] permutation during compile-time !");
+}
+
+TEST(KeccakStateBatch, ColumnsBehaveAsStandaloneStatesX2)
+{
+  test_keccak_state_batch<keccak::X2_STATE_CNT>();
+}
+
+TEST(KeccakStateBatch, ColumnsBehaveAsStandaloneStatesX4)
+{
+  test_keccak_state_batch<keccak::X4_STATE_CNT>();
+}
+
+TEST(KeccakStateBatch, ColumnsBehaveAsStandaloneStatesX8)
+{
+  test_keccak_state_batch<keccak::X8_STATE_CNT>();
+}
@@ -0,0 +1,213 @@
+#include "sha3/kt128.hpp"
+#include "sha3/turboshake128.hpp"
+#include "test_utils.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <span>
+#include <vector>
+
+namespace {
+
+template<size_t OLEN>
+std::array<uint8_t, OLEN>
+compute_kt128_output(const std::vector<uint8_t>& msg, const std::vector<uint8_t>& customization)
+{
+  std::array<uint8_t, OLEN> out_bytes{};
+  kt128::hash(msg, customization, out_bytes);
+
+  return out_bytes;
+}
+
+// Straight-forward KT128, following section 3.2 of RFC 9861, materializing S and hashing each leaf using `turboshake128_t`.
+std::vector<uint8_t>
+compute_kt128_output_naive(const std::vector<uint8_t>& msg, const std::vector<uint8_t>& customization, const size_t olen)
+{
+  const auto length_encode = [](size_t x) {
+    std::vector<uint8_t> res;
+    for (; x > 0; x >>= 8) {
+      res.insert(res.begin(), static_cast<uint8_t>(x));
+    }
+    res.push_back(static_cast<uint8_t>(res.size()));
+
+    return res;
+  };
+
+  std::vector<uint8_t> s = msg;
+  s.insert(s.end(), customization.begin(), customization.end());
+  const auto encoded_customization_len = length_encode(customization.size());
+  s.insert(s.end(), encoded_customization_len.begin(), encoded_customization_len.end());
+
+  std::vector<uint8_t> out(olen);
+  turboshake128::turboshake128_t final_node;
+
+  if (s.size() <= kt128::CHUNK_BYTE_LEN) {
+    final_node.absorb(s);
+    final_node.finalize<0x07>();
+    final_node.squeeze(out);
+
+    return out;
+  }
+
+  const auto s_span = std::span(s);
+  final_node.absorb(s_span.first(kt128::CHUNK_BYTE_LEN));
+  final_node.absorb(std::array<uint8_t, 8>{ 0x03 });
+
+  size_t leaf_cnt = 0;
+  for (size_t off = kt128::CHUNK_BYTE_LEN; off < s.size(); off += kt128::CHUNK_BYTE_LEN) {
+    std::array<uint8_t, kt128::CV_BYTE_LEN> cv{};
+
+    turboshake128::turboshake128_t leaf_node;
+    leaf_node.absorb(s_span.subspan(off, std::min(kt128::CHUNK_BYTE_LEN, s.size() - off)));
+    leaf_node.finalize<0x0b>();
+    leaf_node.squeeze(cv);
+
+    final_node.absorb(cv);
+    leaf_cnt++;
+  }
+
+  final_node.absorb(length_encode(leaf_cnt));
+  final_node.absorb(std::array<uint8_t, 2>{ 0xff, 0xff });
+  final_node.finalize<0x06>();
+  final_node.squeeze(out);
+
+  return out;
+}
+
+}
+
+// Ensure that KT128 implementation is conformant with RFC 9861 https://datatracker.ietf.org/doc/rfc9861, by using test vectors defined there.
+TEST(Sha3XOF, KT128KnownAnswerTests)
+{
+  // clang-format off
+  EXPECT_EQ((compute_kt128_output<32>({}, {})), sha3_test_utils::from_hex<32>("1ac2d450fc3b4205d19da7bfca1b37513c0803577ac7167f06fe2ce1f0ef39e5"));
+  EXPECT_EQ((compute_kt128_output<64>({}, {})), sha3_test_utils::from_hex<64>("1ac2d450fc3b4205d19da7bfca1b37513c0803577ac7167f06fe2ce1f0ef39e54269c056b8c82e48276038b6d292966cc07a3d4645272e31ff38508139eb0a71"));
+
+  {
+    auto out = compute_kt128_output<10032>({}, {});
+    auto out_span = std::span(out);
+    EXPECT_TRUE(std::ranges::equal(out_span.last<32>(), sha3_test_utils::from_hex<32>("e8dc563642f7228c84684c898405d3a834799158c079b12880277a1d28e2ff6d")));
+  }
+
+  EXPECT_EQ((compute_kt128_output<32>(sha3_test_utils::ptn(1), {})), sha3_test_utils::from_hex<32>("2bda92450e8b147f8a7cb629e784a058efca7cf7d8218e02d345dfaa65244a1f"));
+  EXPECT_EQ((compute_kt128_output<32>(sha3_test_utils::ptn(17UL), {})), sha3_test_utils::from_hex<32>("6bf75fa2239198db4772e36478f8e19b0f371205f6a9a93a273f51df37122888"));
+  EXPECT_EQ((compute_kt128_output<32>(sha3_test_utils::ptn(17UL * 17UL), {})), sha3_test_utils::from_hex<32>("0c315ebcdedbf61426de7dcf8fb725d1e74675d7f5327a5067f367b108ecb67c"));
+  EXPECT_EQ((compute_kt128_output<32>(sha3_test_utils::ptn(17UL * 17UL * 17UL), {})), sha3_test_utils::from_hex<32>("cb552e2ec77d9910701d578b457ddf772c12e322e4ee7fe417f92c758f0d59d0"));
+  EXPECT_EQ((compute_kt128_output<32>(sha3_test_utils::ptn(17UL * 17UL * 17UL * 17UL), {})), sha3_test_utils::from_hex<32>("8701045e22205345ff4dda05555cbb5c3af1a771c2b89baef37db43d9998b9fe"));
+  EXPECT_EQ((compute_kt128_output<32>(sha3_test_utils::ptn(17UL * 17UL * 17UL * 17UL * 17UL), {})), sha3_test_utils::from_hex<32>("844d610933b1b9963cbdeb5ae3b6b05cc7cbd67ceedf883eb678a0a8e0371682"));
+  EXPECT_EQ((compute_kt128_output<32>(sha3_test_utils::ptn(17UL * 17UL * 17UL * 17UL * 17UL * 17UL), {})), sha3_test_utils::from_hex<32>("3c390782a8a4e89fa6367f72feaaf13255c8d95878481d3cd8ce85f58e880af8"));
+
+  EXPECT_EQ((compute_kt128_output<32>({}, sha3_test_utils::ptn(1))), sha3_test_utils::from_hex<32>("fab658db63e94a246188bf7af69a133045f46ee984c56e3c3328caaf1aa1a583"));
+  EXPECT_EQ((compute_kt128_output<32>({ 0xff }, sha3_test_utils::ptn(41))), sha3_test_utils::from_hex<32>("d848c5068ced736f4462159b9867fd4c20b808acc3d5bc48e0b06ba0a3762ec4"));
+  EXPECT_EQ((compute_kt128_output<32>({ 0xff, 0xff, 0xff }, sha3_test_utils::ptn(41UL * 41UL))), sha3_test_utils::from_hex<32>("c389e5009ae57120854c2e8c64670ac01358cf4c1baf89447a724234dc7ced74"));
+  EXPECT_EQ((compute_kt128_output<32>({ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }, sha3_test_utils::ptn(41UL * 41UL * 41UL))), sha3_test_utils::from_hex<32>("75d2f86a2e644566726b4fbcfc5657b9dbcf070c7b0dca06450ab291d7443bcf"));
+
+  EXPECT_EQ((compute_kt128_output<32>(sha3_test_utils::ptn(8191), {})), sha3_test_utils::from_hex<32>("1b577636f723643e990cc7d6a659837436fd6a103626600eb8301cd1dbe553d6"));
+  EXPECT_EQ((compute_kt128_output<32>(sha3_test_utils::ptn(8192), {})), sha3_test_utils::from_hex<32>("48f256f6772f9edfb6a8b661ec92dc93b95ebd05a08a17b39ae3490870c926c3"));
+  EXPECT_EQ((compute_kt128_output<32>(sha3_test_utils::ptn(8192), sha3_test_utils::ptn(8189))), sha3_test_utils::from_hex<32>("3ed12f70fb05ddb58689510ab3e4d23c6c6033849aa01e1d8c220a297fedcd0b"));
+  EXPECT_EQ((compute_kt128_output<32>(sha3_test_utils::ptn(8192), sha3_test_utils::ptn(8190))), sha3_test_utils::from_hex<32>("6a7c1b6a5cd0d8c9ca943a4a216cc64604559a2ea45f78570a15253d67ba00ae"));
+  // clang-format on
+}
+
+// Ensure that KT128, hashing leaves in lanes of multi-buffer permutation and across threads of a pool, produces same output as a straight-forward
+// implementation, for inputs around chunk boundaries and with customization strings straddling chunks.
+TEST(Sha3XOF, KT128MatchesNaiveTreeHashing)
+{
+  constexpr size_t OLEN = 200;
+  constexpr size_t CHUNK = kt128::CHUNK_BYTE_LEN;
+
+  constexpr std::array<size_t, 9> MSG_LENS{ 0, CHUNK - 1, CHUNK, CHUNK + 1, 2 * CHUNK, (5 * CHUNK) + 3, 9 * CHUNK, (17 * CHUNK) - 5, 40 * CHUNK };
+  constexpr std::array<size_t, 4> CUSTOMIZATION_LENS{ 0, 7, CHUNK - 3, CHUNK + 11 };
+
+  kt128::thread_pool_t pool(3);
+
+  for (const size_t mlen : MSG_LENS) {
+    for (const size_t clen : CUSTOMIZATION_LENS) {
+      std::vector<uint8_t> msg(mlen);
+      std::vector<uint8_t> customization(clen);
+
+      sha3_test_utils::random_data<uint8_t>(msg);
+      sha3_test_utils::random_data<uint8_t>(customization);
+
+      const auto expected = compute_kt128_output_naive(msg, customization, OLEN);
+
+      std::vector<uint8_t> computed(OLEN);
+      kt128::hash(msg, customization, computed);
+      EXPECT_EQ(computed, expected) << "mlen = " << mlen << ", clen = " << clen;
+
+      std::vector<uint8_t> computed_in_parallel(OLEN);
+      kt128::hash(msg, customization, computed_in_parallel, pool);
+      EXPECT_EQ(computed_in_parallel, expected) << "mlen = " << mlen << ", clen = " << clen;
+    }
+  }
+}
+
+namespace {
+
+// Absorbs `msg` into incremental KT128 hasher `hasher`, in pieces of varying length, finalizes it with `customization` and squeezes `olen` -bytes, in pieces.
+std::vector<uint8_t>
+compute_kt128_output_incrementally(kt128::kt128_t& hasher, std::span<const uint8_t> msg, std::span<const uint8_t> customization, const size_t olen)
+{
+  constexpr std::array<size_t, 5> PIECE_LENS{ 1, 13, 4096, 8193, 70000 };
+
+  size_t off = 0;
+  for (size_t i = 0; off < msg.size(); i++) {
+    const size_t piece_len = std::min(PIECE_LENS[i % PIECE_LENS.size()], msg.size() - off);
+
+    hasher.absorb(msg.subspan(off, piece_len));
+    off += piece_len;
+  }
+
+  hasher.finalize(customization);
+
+  std::vector<uint8_t> out(olen);
+  auto out_span = std::span(out);
+
+  for (off = 0; off < olen;) {
+    const size_t piece_len = std::min<size_t>(off + 1, olen - off);
+
+    hasher.squeeze(out_span.subspan(off, piece_len));
+    off += piece_len;
+  }
+
+  return out;
+}
+
+}
+
+// Ensure that incremental KT128, absorbing message in pieces and hashing leaves on the calling thread or on background workers, produces same output as
+// one-shot KT128, also after being reset.
+TEST(Sha3XOF, KT128IncrementalAbsorptionAndSqueezing)
+{
+  constexpr size_t OLEN = 300;
+  constexpr size_t CHUNK = kt128::CHUNK_BYTE_LEN;
+  constexpr size_t BATCH = kt128::kt128_t::BATCH_BYTE_LEN;
+
+  constexpr std::array<size_t, 10> MSG_LENS{ 0, 100, CHUNK - 1, CHUNK, CHUNK + 1, BATCH, BATCH + CHUNK, (3 * BATCH) + 5, 9 * BATCH, (13 * BATCH) - 1 };
+  constexpr std::array<size_t, 3> CUSTOMIZATION_LENS{ 0, 9, CHUNK + 3 };
+
+  kt128::thread_pool_t pool(3);
+
+  kt128::kt128_t hasher;
+  kt128::kt128_t hasher_in_background(pool);
+
+  for (const size_t mlen : MSG_LENS) {
+    for (const size_t clen : CUSTOMIZATION_LENS) {
+      std::vector<uint8_t> msg(mlen);
+      std::vector<uint8_t> customization(clen);
+
+      sha3_test_utils::random_data<uint8_t>(msg);
+      sha3_test_utils::random_data<uint8_t>(customization);
+
+      std::vector<uint8_t> expected(OLEN);
+      kt128::hash(msg, customization, expected);
+
+      EXPECT_EQ(compute_kt128_output_incrementally(hasher, msg, customization, OLEN), expected) << "mlen = " << mlen << ", clen = " << clen;
+      EXPECT_EQ(compute_kt128_output_incrementally(hasher_in_background, msg, customization, OLEN), expected) << "mlen = " << mlen << ", clen = " << clen;
+
+      hasher.reset();
+      hasher_in_background.reset();
+    }
+  }
+}
@@ -0,0 +1,180 @@
+#include "sha3/kt256.hpp"
+#include "sha3/turboshake256.hpp"
+#include "test_utils.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <span>
+#include <vector>
+
+namespace {
+
+template<size_t OLEN>
+std::array<uint8_t, OLEN>
+compute_kt256_output(const std::vector<uint8_t>& msg, const std::vector<uint8_t>& customization)
+{
+  std::array<uint8_t, OLEN> out_bytes{};
+  kt256::hash(msg, customization, out_bytes);
+
+  return out_bytes;
+}
+
+// Straight-forward KT256, following section 3.2 of RFC 9861, materializing S and hashing each leaf using `turboshake256_t`.
+std::vector<uint8_t>
+compute_kt256_output_naive(const std::vector<uint8_t>& msg, const std::vector<uint8_t>& customization, const size_t olen)
+{
+  const auto length_encode = [](size_t x) {
+    std::vector<uint8_t> res;
+    for (; x > 0; x >>= 8) {
+      res.insert(res.begin(), static_cast<uint8_t>(x));
+    }
+    res.push_back(static_cast<uint8_t>(res.size()));
+
+    return res;
+  };
+
+  std::vector<uint8_t> s = msg;
+  s.insert(s.end(), customization.begin(), customization.end());
+  const auto encoded_customization_len = length_encode(customization.size());
+  s.insert(s.end(), encoded_customization_len.begin(), encoded_customization_len.end());
+
+  std::vector<uint8_t> out(olen);
+  turboshake256::turboshake256_t final_node;
+
+  if (s.size() <= kt256::CHUNK_BYTE_LEN) {
+    final_node.absorb(s);
+    final_node.finalize<0x07>();
+    final_node.squeeze(out);
+
+    return out;
+  }
+
+  const auto s_span = std::span(s);
+  final_node.absorb(s_span.first(kt256::CHUNK_BYTE_LEN));
+  final_node.absorb(std::array<uint8_t, 8>{ 0x03 });
+
+  size_t leaf_cnt = 0;
+  for (size_t off = kt256::CHUNK_BYTE_LEN; off < s.size(); off += kt256::CHUNK_BYTE_LEN) {
+    std::array<uint8_t, kt256::CV_BYTE_LEN> cv{};
+
+    turboshake256::turboshake256_t leaf_node;
+    leaf_node.absorb(s_span.subspan(off, std::min(kt256::CHUNK_BYTE_LEN, s.size() - off)));
+    leaf_node.finalize<0x0b>();
+    leaf_node.squeeze(cv);
+
+    final_node.absorb(cv);
+    leaf_cnt++;
+  }
+
+  final_node.absorb(length_encode(leaf_cnt));
+  final_node.absorb(std::array<uint8_t, 2>{ 0xff, 0xff });
+  final_node.finalize<0x06>();
+  final_node.squeeze(out);
+
+  return out;
+}
+
+}
+
+// Ensure that KT256 implementation is conformant with RFC 9861 https://datatracker.ietf.org/doc/rfc9861, by using test vectors defined there.
+TEST(Sha3XOF, KT256KnownAnswerTests)
+{
+  // clang-format off
+  EXPECT_EQ((compute_kt256_output<64>({}, {})), sha3_test_utils::from_hex<64>("b23d2e9cea9f4904e02bec06817fc10ce38ce8e93ef4c89e6537076af8646404e3e8b68107b8833a5d30490aa33482353fd4adc7148ecb782855003aaebde4a9"));
+  EXPECT_EQ((compute_kt256_output<128>({}, {})), sha3_test_utils::from_hex<128>("b23d2e9cea9f4904e02bec06817fc10ce38ce8e93ef4c89e6537076af8646404e3e8b68107b8833a5d30490aa33482353fd4adc7148ecb782855003aaebde4a9b0925319d8ea1e121a609821ec19efea89e6d08daee1662b69c840289f188ba860f55760b61f82114c030c97e5178449608ccd2cd2d919fc7829ff69931ac4d0"));
+
+  {
+    auto out = compute_kt256_output<10064>({}, {});
+    auto out_span = std::span(out);
+    EXPECT_TRUE(std::ranges::equal(out_span.last<32>(), sha3_test_utils::from_hex<32>("56c64fe94958e7085f2964888259b9932752f3ccd855288efee5fcbb8b563069")));
+  }
+
+  EXPECT_EQ((compute_kt256_output<64>(sha3_test_utils::ptn(1), {})), sha3_test_utils::from_hex<64>("0d005a194085360217128cf17f91e1f71314efa5564539d444912e3437efa17f82db6f6ffe76e781eaa068bce01f2bbf81eacb983d7230f2fb02834a21b1ddd0"));
+  EXPECT_EQ((compute_kt256_output<64>(sha3_test_utils::ptn(17UL), {})), sha3_test_utils::from_hex<64>("1ba3c02b1fc514474f06c8979978a9056c8483f4a1b63d0dccefe3a28a2f323e1cdcca40ebf006ac76ef0397152346837b1277d3e7faa9c9653b19075098527b"));
+  EXPECT_EQ((compute_kt256_output<64>(sha3_test_utils::ptn(17UL * 17UL), {})), sha3_test_utils::from_hex<64>("de8ccbc63e0f133ebb4416814d4c66f691bbf8b6a61ec0a7700f836b086cb029d54f12ac7159472c72db118c35b4e6aa213c6562caaa9dcc518959e69b10f3ba"));
+  EXPECT_EQ((compute_kt256_output<64>(sha3_test_utils::ptn(17UL * 17UL * 17UL), {})), sha3_test_utils::from_hex<64>("647efb49fe9d717500171b41e7f11bd491544443209997ce1c2530d15eb1ffbb598935ef954528ffc152b1e4d731ee2683680674365cd191d562bae753b84aa5"));
+  EXPECT_EQ((compute_kt256_output<64>(sha3_test_utils::ptn(17UL * 17UL * 17UL * 17UL), {})), sha3_test_utils::from_hex<64>("b06275d284cd1cf205bcbe57dccd3ec1ff6686e3ed15776383e1f2fa3c6ac8f08bf8a162829db1a44b2a43ff83dd89c3cf1ceb61ede659766d5ccf817a62ba8d"));
+  EXPECT_EQ((compute_kt256_output<64>(sha3_test_utils::ptn(17UL * 17UL * 17UL * 17UL * 17UL), {})), sha3_test_utils::from_hex<64>("9473831d76a4c7bf77ace45b59f1458b1673d64bcd877a7c66b2664aa6dd149e60eab71b5c2bab858c074ded81ddce2b4022b5215935c0d4d19bf511aeeb0772"));
+  EXPECT_EQ((compute_kt256_output<64>(sha3_test_utils::ptn(17UL * 17UL * 17UL * 17UL * 17UL * 17UL), {})), sha3_test_utils::from_hex<64>("0652b740d78c5e1f7c8dcc1777097382768b7ff38f9a7a20f29f413bb1b3045b31a5578f568f911e09cf44746da84224a5266e96a4a535e871324e4f9c7004da"));
+
+  EXPECT_EQ((compute_kt256_output<64>({}, sha3_test_utils::ptn(1))), sha3_test_utils::from_hex<64>("9280f5cc39b54a5a594ec63de0bb99371e4609d44bf845c2f5b8c316d72b159811f748f23e3fabbe5c3226ec96c62186df2d33e9df74c5069ceecbb4dd10eff6"));
+  EXPECT_EQ((compute_kt256_output<64>({ 0xff }, sha3_test_utils::ptn(41))), sha3_test_utils::from_hex<64>("47ef96dd616f200937aa7847e34ec2feae8087e3761dc0f8c1a154f51dc9ccf845d7adbce57ff64b639722c6a1672e3bf5372d87e00aff89be97240756998853"));
+  EXPECT_EQ((compute_kt256_output<64>({ 0xff, 0xff, 0xff }, sha3_test_utils::ptn(41UL * 41UL))), sha3_test_utils::from_hex<64>("3b48667a5051c5966c53c5d42b95de451e05584e7806e2fb765eda959074172cb438a9e91dde337c98e9c41bed94c4e0aef431d0b64ef2324f7932caa6f54969"));
+  EXPECT_EQ((compute_kt256_output<64>({ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }, sha3_test_utils::ptn(41UL * 41UL * 41UL))), sha3_test_utils::from_hex<64>("e0911cc00025e1540831e266d94add9b98712142b80d2629e643aac4efaf5a3a30a88cbf4ac2a91a2432743054fbcc9897670e86ba8cec2fc2ace9c966369724"));
+
+  EXPECT_EQ((compute_kt256_output<64>(sha3_test_utils::ptn(8191), {})), sha3_test_utils::from_hex<64>("3081434d93a4108d8d8a3305b89682cebedc7ca4ea8a3ce869fbb73cbe4a58eef6f24de38ffc170514c70e7ab2d01f03812616e863d769afb3753193ba045b20"));
+  EXPECT_EQ((compute_kt256_output<64>(sha3_test_utils::ptn(8192), {})), sha3_test_utils::from_hex<64>("c6ee8e2ad3200c018ac87aaa031cdac22121b412d07dc6e0dccbb53423747e9a1c18834d99df596cf0cf4b8dfafb7bf02d139d0c9035725adc1a01b7230a41fa"));
+  EXPECT_EQ((compute_kt256_output<64>(sha3_test_utils::ptn(8192), sha3_test_utils::ptn(8189))), sha3_test_utils::from_hex<64>("74e47879f10a9c5d11bd2da7e194fe57e86378bf3c3f7448eff3c576a0f18c5caae0999979512090a7f348af4260d4de3c37f1ecaf8d2c2c96c1d16c64b12496"));
+  EXPECT_EQ((compute_kt256_output<64>(sha3_test_utils::ptn(8192), sha3_test_utils::ptn(8190))), sha3_test_utils::from_hex<64>("f4b5908b929ffe01e0f79ec2f21243d41a396b2e7303a6af1d6399cd6c7a0a2dd7c4f607e8277f9c9b1cb4ab9ddc59d4b92d1fc7558441f1832c3279a4241b8b"));
+  // clang-format on
+}
+
+// Ensure that KT256, hashing leaves in lanes of multi-buffer permutation and across threads of a pool, produces same output as a straight-forward
+// implementation, for inputs around chunk boundaries and with customization strings straddling chunks.
+TEST(Sha3XOF, KT256MatchesNaiveTreeHashing)
+{
+  constexpr size_t OLEN = 200;
+  constexpr size_t CHUNK = kt256::CHUNK_BYTE_LEN;
+
+  constexpr std::array<size_t, 9> MSG_LENS{ 0, CHUNK - 1, CHUNK, CHUNK + 1, 2 * CHUNK, (5 * CHUNK) + 3, 9 * CHUNK, (17 * CHUNK) - 5, 40 * CHUNK };
+  constexpr std::array<size_t, 4> CUSTOMIZATION_LENS{ 0, 7, CHUNK - 3, CHUNK + 11 };
+
+  kt256::thread_pool_t pool(3);
+
+  for (const size_t mlen : MSG_LENS) {
+    for (const size_t clen : CUSTOMIZATION_LENS) {
+      std::vector<uint8_t> msg(mlen);
+      std::vector<uint8_t> customization(clen);
+
+      sha3_test_utils::random_data<uint8_t>(msg);
+      sha3_test_utils::random_data<uint8_t>(customization);
+
+      const auto expected = compute_kt256_output_naive(msg, customization, OLEN);
+
+      std::vector<uint8_t> computed(OLEN);
+      kt256::hash(msg, customization, computed);
+      EXPECT_EQ(computed, expected) << "mlen = " << mlen << ", clen = " << clen;
+
+      std::vector<uint8_t> computed_in_parallel(OLEN);
+      kt256::hash(msg, customization, computed_in_parallel, pool);
+      EXPECT_EQ(computed_in_parallel, expected) << "mlen = " << mlen << ", clen = " << clen;
+    }
+  }
+}
+
+// Ensure that incremental KT256, absorbing message in pieces, on background workers, produces same output as one-shot KT256.
+TEST(Sha3XOF, KT256IncrementalAbsorptionAndSqueezing)
+{
+  constexpr size_t OLEN = 300;
+  constexpr size_t CHUNK = kt256::CHUNK_BYTE_LEN;
+  constexpr size_t BATCH = kt256::kt256_t::BATCH_BYTE_LEN;
+
+  constexpr std::array<size_t, 6> MSG_LENS{ 0, CHUNK - 1, CHUNK, CHUNK + 1, BATCH + 7, (7 * BATCH) + CHUNK };
+  constexpr size_t PIECE_LEN = 5000;
+
+  kt256::thread_pool_t pool(2);
+
+  for (const size_t mlen : MSG_LENS) {
+    std::vector<uint8_t> msg(mlen);
+    std::vector<uint8_t> customization(17);
+
+    sha3_test_utils::random_data<uint8_t>(msg);
+    sha3_test_utils::random_data<uint8_t>(customization);
+
+    std::vector<uint8_t> expected(OLEN);
+    kt256::hash(msg, customization, expected);
+
+    kt256::kt256_t hasher(pool);
+    for (size_t off = 0; off < mlen; off += PIECE_LEN) {
+      hasher.absorb(std::span(msg).subspan(off, std::min(PIECE_LEN, mlen - off)));
+    }
+    hasher.finalize(customization);
+
+    std::vector<uint8_t> computed(OLEN);
+    hasher.squeeze(std::span(computed).first(OLEN / 2));
+    hasher.squeeze(std::span(computed).subspan(OLEN / 2));
+
+    EXPECT_EQ(computed, expected) << "mlen = " << mlen;
+  }
+}
@@ -0,0 +1,183 @@
+#include "sha3/cshake128.hpp"
+#include "sha3/parallelhash128.hpp"
+#include "sha3/shake128.hpp"
+#include "test_utils.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+std::vector<uint8_t>
+to_bytes(std::string_view str)
+{
+  return { str.begin(), str.end() };
+}
+
+template<size_t OLEN, bool xof>
+std::array<uint8_t, OLEN>
+compute_parallelhash128_output(const std::vector<uint8_t>& msg, const size_t block_len, const std::vector<uint8_t>& customization)
+{
+  std::array<uint8_t, OLEN> out_bytes{};
+
+  if constexpr (xof) {
+    parallelhash128::xof(msg, block_len, customization, out_bytes);
+  } else {
+    parallelhash128::hash(msg, block_len, customization, out_bytes);
+  }
+
+  return out_bytes;
+}
+
+// Straight-forward ParallelHash128, following section 6.3 of SP 800-185, hashing each block using `shake128_t` and the final node using `cshake128_t`.
+std::vector<uint8_t>
+compute_parallelhash128_output_naive(const std::vector<uint8_t>& msg,
+                                     const size_t block_len,
+                                     const std::vector<uint8_t>& customization,
+                                     const size_t olen,
+                                     const bool xof)
+{
+  const auto encode = [](size_t x) {
+    std::vector<uint8_t> res;
+    do {
+      res.insert(res.begin(), static_cast<uint8_t>(x));
+      x >>= 8;
+    } while (x > 0);
+
+    return res;
+  };
+  const auto left_encode = [&](const size_t x) {
+    auto res = encode(x);
+    res.insert(res.begin(), static_cast<uint8_t>(res.size()));
+
+    return res;
+  };
+  const auto right_encode = [&](const size_t x) {
+    auto res = encode(x);
+    res.push_back(static_cast<uint8_t>(res.size()));
+
+    return res;
+  };
+
+  const auto msg_span = std::span(msg);
+
+  cshake128::cshake128_t final_node(to_bytes("ParallelHash"), customization);
+  final_node.absorb(left_encode(block_len));
+
+  size_t block_cnt = 0;
+  for (size_t off = 0; off < msg.size(); off += block_len) {
+    std::array<uint8_t, parallelhash128::CV_BYTE_LEN> cv{};
+
+    shake128::shake128_t block_node;
+    block_node.absorb(msg_span.subspan(off, std::min(block_len, msg.size() - off)));
+    block_node.finalize();
+    block_node.squeeze(cv);
+
+    final_node.absorb(cv);
+    block_cnt++;
+  }
+
+  final_node.absorb(right_encode(block_cnt));
+  final_node.absorb(right_encode(xof ? 0 : olen * 8));
+  final_node.finalize();
+
+  std::vector<uint8_t> out(olen);
+  final_node.squeeze(out);
+
+  return out;
+}
+
+}
+
+// Ensure that ParallelHash128 and ParallelHashXOF128 implementations are conformant with NIST SP 800-185, by using sample values published at
+// https://csrc.nist.gov/projects/cryptographic-standards-and-guidelines/example-values, along with a longer message, split into many blocks.
+TEST(Sha3XOF, ParallelHash128KnownAnswerTests)
+{
+  std::vector<uint8_t> x24;
+  std::vector<uint8_t> x72;
+
+  for (uint8_t i = 0; i < 6; i++) {
+    for (uint8_t j = 0; j < 12; j++) {
+      if ((i < 3) && (j < 8)) {
+        x24.push_back(static_cast<uint8_t>((i << 4) | j));
+      }
+      x72.push_back(static_cast<uint8_t>((i << 4) | j));
+    }
+  }
+
+  // clang-format off
+  EXPECT_EQ((compute_parallelhash128_output<32, false>(x24, 8, {})), sha3_test_utils::from_hex<32>("ba8dc1d1d979331d3f813603c67f72609ab5e44b94a0b8f9af46514454a2b4f5"));
+  EXPECT_EQ((compute_parallelhash128_output<32, false>(x24, 8, to_bytes("Parallel Data"))), sha3_test_utils::from_hex<32>("fc484dcb3f84dceedc353438151bee58157d6efed0445a81f165e495795b7206"));
+  EXPECT_EQ((compute_parallelhash128_output<32, false>(x72, 12, to_bytes("Parallel Data"))), sha3_test_utils::from_hex<32>("f7fd5312896c6685c828af7e2adb97e393e7f8d54e3c2ea4b95e5aca3796e8fc"));
+  EXPECT_EQ((compute_parallelhash128_output<32, false>(sha3_test_utils::ptn(70000), 1000, to_bytes("Parallel Data"))), sha3_test_utils::from_hex<32>("daa82e27cdc8ad660c6f2afca074be9f3567376e1016561914139d918828179c"));
+  EXPECT_EQ((compute_parallelhash128_output<32, true>(x24, 8, {})), sha3_test_utils::from_hex<32>("fe47d661e49ffe5b7d999922c062356750caf552985b8e8ce6667f2727c3c8d3"));
+  EXPECT_EQ((compute_parallelhash128_output<32, true>(x24, 8, to_bytes("Parallel Data"))), sha3_test_utils::from_hex<32>("ea2a793140820f7a128b8eb70a9439f93257c6e6e79b4a540d291d6dae7098d7"));
+  EXPECT_EQ((compute_parallelhash128_output<32, true>(x72, 12, to_bytes("Parallel Data"))), sha3_test_utils::from_hex<32>("0127ad9772ab904691987fcc4a24888f341fa0db2145e872d4efd255376602f0"));
+  EXPECT_EQ((compute_parallelhash128_output<32, true>(sha3_test_utils::ptn(70000), 1000, to_bytes("Parallel Data"))), sha3_test_utils::from_hex<32>("a13bdbc01afe8d2cfe73a3cc7a0a22593f742037c7e923fbb2b31f86698079da"));
+  // clang-format on
+}
+
+// Ensure that ParallelHash128, hashing blocks in lanes of multi-buffer permutation and across threads of a pool, produces same output as a
+// straight-forward implementation, for block lengths around rate of the sponge and messages around block boundaries.
+TEST(Sha3XOF, ParallelHash128MatchesNaiveHashing)
+{
+  constexpr size_t OLEN = 200;
+  constexpr size_t RATE_BYTES = cshake128::RATE / 8;
+
+  constexpr std::array<size_t, 6> BLOCK_LENS{ 1, 8, RATE_BYTES - 1, RATE_BYTES, (3 * RATE_BYTES) + 5, 8192 };
+  constexpr std::array<size_t, 6> BLOCK_CNTS{ 0, 1, 3, 9, 17, 300 };
+
+  parallelhash128::thread_pool_t pool(3);
+
+  for (const size_t block_len : BLOCK_LENS) {
+    for (const size_t block_cnt : BLOCK_CNTS) {
+      for (const size_t mlen : { block_len * block_cnt, (block_len * block_cnt) + (block_len / 2) + 1 }) {
+        std::vector<uint8_t> msg(mlen);
+        std::vector<uint8_t> customization(block_cnt);
+
+        sha3_test_utils::random_data<uint8_t>(msg);
+        sha3_test_utils::random_data<uint8_t>(customization);
+
+        for (const bool xof : { false, true }) {
+          const auto expected = compute_parallelhash128_output_naive(msg, block_len, customization, OLEN, xof);
+
+          std::vector<uint8_t> computed(OLEN);
+          std::vector<uint8_t> computed_on_pool(OLEN);
+
+          if (xof) {
+            parallelhash128::xof(msg, block_len, customization, computed);
+            parallelhash128::xof(msg, block_len, customization, computed_on_pool, pool);
+          } else {
+            parallelhash128::hash(msg, block_len, customization, computed);
+            parallelhash128::hash(msg, block_len, customization, computed_on_pool, pool);
+          }
+
+          EXPECT_EQ(computed, expected) << "block_len = " << block_len << ", mlen = " << mlen << ", xof = " << xof;
+          EXPECT_EQ(computed_on_pool, expected) << "block_len = " << block_len << ", mlen = " << mlen << ", xof = " << xof;
+        }
+      }
+    }
+  }
+}
+
+// Ensure that output of ParallelHashXOF128 is a prefix of any longer output, while output of ParallelHash128 depends on its requested length.
+TEST(Sha3XOF, ParallelHash128OutputLengthBinding)
+{
+  std::vector<uint8_t> msg(10000);
+  sha3_test_utils::random_data<uint8_t>(msg);
+
+  std::vector<uint8_t> short_out(50);
+  std::vector<uint8_t> long_out(500);
+
+  parallelhash128::xof(msg, 512, {}, short_out);
+  parallelhash128::xof(msg, 512, {}, long_out);
+  EXPECT_TRUE(std::ranges::equal(short_out, std::span(long_out).first(short_out.size())));
+
+  parallelhash128::hash(msg, 512, {}, short_out);
+  parallelhash128::hash(msg, 512, {}, long_out);
+  EXPECT_FALSE(std::ranges::equal(short_out, std::span(long_out).first(short_out.size())));
+}
@@ -0,0 +1,183 @@
+#include "sha3/cshake256.hpp"
+#include "sha3/parallelhash256.hpp"
+#include "sha3/shake256.hpp"
+#include "test_utils.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+std::vector<uint8_t>
+to_bytes(std::string_view str)
+{
+  return { str.begin(), str.end() };
+}
+
+template<size_t OLEN, bool xof>
+std::array<uint8_t, OLEN>
+compute_parallelhash256_output(const std::vector<uint8_t>& msg, const size_t block_len, const std::vector<uint8_t>& customization)
+{
+  std::array<uint8_t, OLEN> out_bytes{};
+
+  if constexpr (xof) {
+    parallelhash256::xof(msg, block_len, customization, out_bytes);
+  } else {
+    parallelhash256::hash(msg, block_len, customization, out_bytes);
+  }
+
+  return out_bytes;
+}
+
+// Straight-forward ParallelHash256, following section 6.3 of SP 800-185, hashing each block using `shake256_t` and the final node using `cshake256_t`.
+std::vector<uint8_t>
+compute_parallelhash256_output_naive(const std::vector<uint8_t>& msg,
+                                     const size_t block_len,
+                                     const std::vector<uint8_t>& customization,
+                                     const size_t olen,
+                                     const bool xof)
+{
+  const auto encode = [](size_t x) {
+    std::vector<uint8_t> res;
+    do {
+      res.insert(res.begin(), static_cast<uint8_t>(x));
+      x >>= 8;
+    } while (x > 0);
+
+    return res;
+  };
+  const auto left_encode = [&](const size_t x) {
+    auto res = encode(x);
+    res.insert(res.begin(), static_cast<uint8_t>(res.size()));
+
+    return res;
+  };
+  const auto right_encode = [&](const size_t x) {
+    auto res = encode(x);
+    res.push_back(static_cast<uint8_t>(res.size()));
+
+    return res;
+  };
+
+  const auto msg_span = std::span(msg);
+
+  cshake256::cshake256_t final_node(to_bytes("ParallelHash"), customization);
+  final_node.absorb(left_encode(block_len));
+
+  size_t block_cnt = 0;
+  for (size_t off = 0; off < msg.size(); off += block_len) {
+    std::array<uint8_t, parallelhash256::CV_BYTE_LEN> cv{};
+
+    shake256::shake256_t block_node;
+    block_node.absorb(msg_span.subspan(off, std::min(block_len, msg.size() - off)));
+    block_node.finalize();
+    block_node.squeeze(cv);
+
+    final_node.absorb(cv);
+    block_cnt++;
+  }
+
+  final_node.absorb(right_encode(block_cnt));
+  final_node.absorb(right_encode(xof ? 0 : olen * 8));
+  final_node.finalize();
+
+  std::vector<uint8_t> out(olen);
+  final_node.squeeze(out);
+
+  return out;
+}
+
+}
+
+// Ensure that ParallelHash256 and ParallelHashXOF256 implementations are conformant with NIST SP 800-185, by using sample values published at
+// https://csrc.nist.gov/projects/cryptographic-standards-and-guidelines/example-values, along with a longer message, split into many blocks.
+TEST(Sha3XOF, ParallelHash256KnownAnswerTests)
+{
+  std::vector<uint8_t> x24;
+  std::vector<uint8_t> x72;
+
+  for (uint8_t i = 0; i < 6; i++) {
+    for (uint8_t j = 0; j < 12; j++) {
+      if ((i < 3) && (j < 8)) {
+        x24.push_back(static_cast<uint8_t>((i << 4) | j));
+      }
+      x72.push_back(static_cast<uint8_t>((i << 4) | j));
+    }
+  }
+
+  // clang-format off
+  EXPECT_EQ((compute_parallelhash256_output<64, false>(x24, 8, {})), sha3_test_utils::from_hex<64>("bc1ef124da34495e948ead207dd9842235da432d2bbc54b4c110e64c451105531b7f2a3e0ce055c02805e7c2de1fb746af97a1dd01f43b824e31b87612410429"));
+  EXPECT_EQ((compute_parallelhash256_output<64, false>(x24, 8, to_bytes("Parallel Data"))), sha3_test_utils::from_hex<64>("cdf15289b54f6212b4bc270528b49526006dd9b54e2b6add1ef6900dda3963bb33a72491f236969ca8afaea29c682d47a393c065b38e29fae651a2091c833110"));
+  EXPECT_EQ((compute_parallelhash256_output<64, false>(x72, 12, to_bytes("Parallel Data"))), sha3_test_utils::from_hex<64>("69d0fcb764ea055dd09334bc6021cb7e4b61348dff375da262671cdec3effa8d1b4568a6cce16b1cad946ddde27f6ce2b8dee4cd1b24851ebf00eb90d43813e9"));
+  EXPECT_EQ((compute_parallelhash256_output<64, false>(sha3_test_utils::ptn(70000), 1000, to_bytes("Parallel Data"))), sha3_test_utils::from_hex<64>("3edaa956085c27ded2d807ef8d0bd7fe23f30848033dbea6c6fd50bdd2bbecc96cd1bb9af81655b3bcb93fe0d29b7f4ba140fdb370a79b7bf0457f30582d3014"));
+  EXPECT_EQ((compute_parallelhash256_output<64, true>(x24, 8, {})), sha3_test_utils::from_hex<64>("c10a052722614684144d28474850b410757e3cba87651ba167a5cbddff7f466675fbf84bcae7378ac444be681d729499afca667fb879348bfdda427863c82f1c"));
+  EXPECT_EQ((compute_parallelhash256_output<64, true>(x24, 8, to_bytes("Parallel Data"))), sha3_test_utils::from_hex<64>("538e105f1a22f44ed2f5cc1674fbd40be803d9c99bf5f8d90a2c8193f3fe6ea768e5c1a20987e2c9c65febed03887a51d35624ed12377594b5585541dc377efc"));
+  EXPECT_EQ((compute_parallelhash256_output<64, true>(x72, 12, to_bytes("Parallel Data"))), sha3_test_utils::from_hex<64>("6b3e790b330c889a204c2fbc728d809f19367328d852f4002dc829f73afd6bcefb7fe5b607b13a801c0be5c1170bdb794e339458fdb0e62a6af3d42558970249"));
+  EXPECT_EQ((compute_parallelhash256_output<64, true>(sha3_test_utils::ptn(70000), 1000, to_bytes("Parallel Data"))), sha3_test_utils::from_hex<64>("4a5cfe8ea936a23dc3beff7fef5205f863259c1ee6c9b8627c0988a4cacd8e5749142eab6764fef8909e2f0254b09fd6d023a52d78614ee558810818c10760f0"));
+  // clang-format on
+}
+
+// Ensure that ParallelHash256, hashing blocks in lanes of multi-buffer permutation and across threads of a pool, produces same output as a
+// straight-forward implementation, for block lengths around rate of the sponge and messages around block boundaries.
+TEST(Sha3XOF, ParallelHash256MatchesNaiveHashing)
+{
+  constexpr size_t OLEN = 200;
+  constexpr size_t RATE_BYTES = cshake256::RATE / 8;
+
+  constexpr std::array<size_t, 6> BLOCK_LENS{ 1, 8, RATE_BYTES - 1, RATE_BYTES, (3 * RATE_BYTES) + 5, 8192 };
+  constexpr std::array<size_t, 6> BLOCK_CNTS{ 0, 1, 3, 9, 17, 300 };
+
+  parallelhash256::thread_pool_t pool(3);
+
+  for (const size_t block_len : BLOCK_LENS) {
+    for (const size_t block_cnt : BLOCK_CNTS) {
+      for (const size_t mlen : { block_len * block_cnt, (block_len * block_cnt) + (block_len / 2) + 1 }) {
+        std::vector<uint8_t> msg(mlen);
+        std::vector<uint8_t> customization(block_cnt);
+
+        sha3_test_utils::random_data<uint8_t>(msg);
+        sha3_test_utils::random_data<uint8_t>(customization);
+
+        for (const bool xof : { false, true }) {
+          const auto expected = compute_parallelhash256_output_naive(msg, block_len, customization, OLEN, xof);
+
+          std::vector<uint8_t> computed(OLEN);
+          std::vector<uint8_t> computed_on_pool(OLEN);
+
+          if (xof) {
+            parallelhash256::xof(msg, block_len, customization, computed);
+            parallelhash256::xof(msg, block_len, customization, computed_on_pool, pool);
+          } else {
+            parallelhash256::hash(msg, block_len, customization, computed);
+            parallelhash256::hash(msg, block_len, customization, computed_on_pool, pool);
+          }
+
+          EXPECT_EQ(computed, expected) << "block_len = " << block_len << ", mlen = " << mlen << ", xof = " << xof;
+          EXPECT_EQ(computed_on_pool, expected) << "block_len = " << block_len << ", mlen = " << mlen << ", xof = " << xof;
+        }
+      }
+    }
+  }
+}
+
+// Ensure that output of ParallelHashXOF256 is a prefix of any longer output, while output of ParallelHash256 depends on its requested length.
+TEST(Sha3XOF, ParallelHash256OutputLengthBinding)
+{
+  std::vector<uint8_t> msg(10000);
+  sha3_test_utils::random_data<uint8_t>(msg);
+
+  std::vector<uint8_t> short_out(50);
+  std::vector<uint8_t> long_out(500);
+
+  parallelhash256::xof(msg, 512, {}, short_out);
+  parallelhash256::xof(msg, 512, {}, long_out);
+  EXPECT_TRUE(std::ranges::equal(short_out, std::span(long_out).first(short_out.size())));
+
+  parallelhash256::hash(msg, 512, {}, short_out);
+  parallelhash256::hash(msg, 512, {}, long_out);
+  EXPECT_FALSE(std::ranges::equal(short_out, std::span(long_out).first(short_out.size())));
+}
@@ -2,10 +2,35 @@
 #include "test_conf.hpp"
 #include "test_utils.hpp"
 #include <algorithm>
+#include <array>
 #include <fstream>
 #include <gtest/gtest.h>
+#include <span>
+#include <utility>
 #include <vector>
 
+namespace {
+
+// Hashes random messages of each of `mlens` -bytes, as spans of static extent, and checks that digests are same as hashing them as spans of dynamic extent.
+template<size_t... mlens>
+void
+test_sha3_256_fixed_len_input(std::index_sequence<mlens...> /* unused */)
+{
+  (
+    []() {
+      std::array<uint8_t, mlens> msg{};
+      sha3_test_utils::random_data<uint8_t>(msg);
+
+      const auto fixed = sha3_256::sha3_256_t::hash(std::span<const uint8_t, mlens>(msg));
+      const auto dynamic = sha3_256::sha3_256_t::hash(std::span<const uint8_t>(msg));
+
+      EXPECT_EQ(fixed, dynamic) << "mlen = " << mlens;
+    }(),
+    ...);
+}
+
+}
+
 // Ensure that SHA3-256 implementation is compile-time evaluable.
 TEST(Sha3Hashing, CompileTimeEvalSha3_256)
 {
@@ -92,3 +117,59 @@ TEST(Sha3Hashing, Sha3_256KnownAnswerTests)
 
   file.close();
 }
+
+// Ensure that batched one-shot hashing of many messages, of both equal and unequal lengths, produces same digests as hashing each of them separately.
+TEST(Sha3Hashing, Sha3_256HashMany)
+{
+  std::vector<std::vector<uint8_t>> msgs;
+  for (size_t mlen = MIN_MSG_LEN; mlen < MAX_MSG_LEN; mlen++) {
+    // Messages of same length appear more than once, s.t. they are hashed together, while the ones longer than a block are stored in descending order.
+    const size_t len = (mlen % 2 == 0) ? (MAX_MSG_LEN - mlen) : (mlen % 64);
+
+    auto& msg = msgs.emplace_back(len);
+    sha3_test_utils::random_data<uint8_t>(msg);
+  }
+
+  std::vector<std::span<const uint8_t>> msg_spans(msgs.begin(), msgs.end());
+  std::vector<std::array<uint8_t, sha3_256::DIGEST_LEN>> computed(msgs.size());
+
+  sha3_256::sha3_256_t::hash_many(msg_spans, computed);
+
+  for (size_t i = 0; i < msgs.size(); i++) {
+    EXPECT_EQ(computed[i], sha3_256::sha3_256_t::hash(msgs[i])) << "mlen = " << msgs[i].size();
+  }
+}
+
+// Ensure that batched one-shot hashing of records, laid out at a fixed stride in a contiguous buffer, produces same digests as hashing each of them separately.
+TEST(Sha3Hashing, Sha3_256HashManyStrided)
+{
+  constexpr size_t RECORD_CNT = 19;
+
+  constexpr std::array<size_t, 4> RECORD_LENS{ 0, 32, 136, 300 };
+
+  for (const size_t record_len : RECORD_LENS) {
+    const size_t stride = record_len + 7;
+
+    std::vector<uint8_t> records(((RECORD_CNT - 1) * stride) + record_len);
+    sha3_test_utils::random_data<uint8_t>(records);
+
+    std::vector<std::array<uint8_t, sha3_256::DIGEST_LEN>> computed(RECORD_CNT);
+    sha3_256::sha3_256_t::hash_many(records, record_len, stride, computed);
+
+    for (size_t i = 0; i < RECORD_CNT; i++) {
+      const auto record = std::span(records).subspan(i * stride, record_len);
+      EXPECT_EQ(computed[i], sha3_256::sha3_256_t::hash(record)) << "record_len = " << record_len << ", i = " << i;
+    }
+  }
+}
+
+// Ensure that hashing messages, whose length is known at compile-time, yields same digest as the generic path, for lengths around multiples of the rate, and
+// that it is compile-time evaluable.
+TEST(Sha3Hashing, Sha3_256FixedLengthInput)
+{
+  test_sha3_256_fixed_len_input(std::index_sequence<0, 1, 31, 32, 64, 128, 135, 136, 137, 277>{});
+
+  constexpr auto input = sha3_test_utils::from_hex<32>("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+  static_assert(sha3_256::sha3_256_t::hash(std::span(input)) == sha3_256::sha3_256_t::hash(std::span<const uint8_t>(input)),
+                "Must be able to compute Sha3-256 hash of fixed length input during compile-time !");
+}
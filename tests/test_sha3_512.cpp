@@ -2,10 +2,35 @@
 #include "test_conf.hpp"
 #include "test_utils.hpp"
 #include <algorithm>
+#include <array>
 #include <fstream>
 #include <gtest/gtest.h>
+#include <span>
+#include <utility>
 #include <vector>
 
+namespace {
+
+// Hashes random messages of each of `mlens` -bytes, as spans of static extent, and checks that digests are same as hashing them as spans of dynamic extent.
+template<size_t... mlens>
+void
+test_sha3_512_fixed_len_input(std::index_sequence<mlens...> /* unused */)
+{
+  (
+    []() {
+      std::array<uint8_t, mlens> msg{};
+      sha3_test_utils::random_data<uint8_t>(msg);
+
+      const auto fixed = sha3_512::sha3_512_t::hash(std::span<const uint8_t, mlens>(msg));
+      const auto dynamic = sha3_512::sha3_512_t::hash(std::span<const uint8_t>(msg));
+
+      EXPECT_EQ(fixed, dynamic) << "mlen = " << mlens;
+    }(),
+    ...);
+}
+
+}
+
 // Ensure that SHA3-512 implementation is compile-time evaluable.
 TEST(Sha3Hashing, CompileTimeEvalSha3_512)
 {
@@ -94,3 +119,14 @@ TEST(Sha3Hashing, Sha3_512KnownAnswerTests)
 
   file.close();
 }
+
+// Ensure that hashing messages, whose length is known at compile-time, yields same digest as the generic path, for lengths around multiples of the rate, and
+// that it is compile-time evaluable.
+TEST(Sha3Hashing, Sha3_512FixedLengthInput)
+{
+  test_sha3_512_fixed_len_input(std::index_sequence<0, 1, 31, 32, 64, 71, 72, 73, 128, 149>{});
+
+  constexpr auto input = sha3_test_utils::from_hex<32>("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+  static_assert(sha3_512::sha3_512_t::hash(std::span(input)) == sha3_512::sha3_512_t::hash(std::span<const uint8_t>(input)),
+                "Must be able to compute Sha3-512 hash of fixed length input during compile-time !");
+}
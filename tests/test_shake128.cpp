@@ -2,8 +2,12 @@
 #include "test_conf.hpp"
 #include "test_utils.hpp"
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
 #include <fstream>
 #include <gtest/gtest.h>
+#include <span>
 #include <vector>
 
 namespace {
@@ -23,6 +27,44 @@ eval_shake128(std::span<const uint8_t> data)
   return out;
 }
 
+/**
+ * Samples `len` values uniform in [0, q), out of SHAKE128 output of `seed`, using `shake128::sample_uniform`, and checks them against the reference
+ * rejection sampler, which squeezes three bytes at a time, as described in SampleNTT of FIPS 203 and RejNTTPoly of FIPS 204.
+ */
+template<uint32_t q, typename T>
+void
+test_shake128_sample_uniform(std::span<const uint8_t> seed, const size_t len)
+{
+  shake128::shake128_t hasher;
+  hasher.absorb(seed);
+  hasher.finalize();
+
+  auto reference = hasher;
+
+  std::vector<T> computed(len);
+  shake128::sample_uniform<q>(hasher, std::span(computed));
+
+  const uint32_t mask = (q <= 4096) ? 0xfffU : ((1U << std::bit_width(q - 1)) - 1U);
+
+  std::vector<T> expected;
+  while (expected.size() < len) {
+    std::array<uint8_t, 3> chunk{};
+    reference.squeeze(chunk);
+
+    const uint32_t cand0 = (chunk[0] | (static_cast<uint32_t>(chunk[1]) << 8U) | (static_cast<uint32_t>(chunk[2]) << 16U)) & mask;
+    const uint32_t cand1 = (chunk[1] >> 4U) | (static_cast<uint32_t>(chunk[2]) << 4U);
+
+    if (cand0 < q) {
+      expected.push_back(static_cast<T>(cand0));
+    }
+    if ((q <= 4096) && (cand1 < q) && (expected.size() < len)) {
+      expected.push_back(static_cast<T>(cand1));
+    }
+  }
+
+  EXPECT_EQ(computed, expected) << "q = " << q << ", len = " << len;
+}
+
 }
 
 // Ensure that SHAKE128 XOF implementation is compile-time evaluable.
@@ -149,3 +191,137 @@ TEST(Sha3XOF, SHAKE128KnownAnswerTests)
 
   file.close();
 }
+
+// Ensure that batched one-shot hashing of many messages produces same output as absorbing, finalizing and squeezing each of them separately, for output
+// lengths spanning multiple blocks.
+TEST(Sha3XOF, SHAKE128HashMany)
+{
+  std::vector<std::vector<uint8_t>> msgs;
+  for (size_t mlen = MIN_MSG_LEN; mlen < MAX_MSG_LEN; mlen += 3) {
+    auto& msg = msgs.emplace_back((mlen % 2 == 0) ? mlen : (mlen % 168));
+    sha3_test_utils::random_data<uint8_t>(msg);
+  }
+
+  std::vector<std::span<const uint8_t>> msg_spans(msgs.begin(), msgs.end());
+
+  constexpr std::array<size_t, 4> OUT_LENS{ 1, 32, 168, 401 };
+
+  for (const size_t olen : OUT_LENS) {
+    std::vector<uint8_t> computed(msgs.size() * olen);
+    shake128::shake128_t::hash_many(msg_spans, computed, olen);
+
+    for (size_t i = 0; i < msgs.size(); i++) {
+      std::vector<uint8_t> expected(olen);
+
+      shake128::shake128_t hasher;
+      hasher.absorb(msgs[i]);
+      hasher.finalize();
+      hasher.squeeze(expected);
+
+      EXPECT_TRUE(std::ranges::equal(std::span(computed).subspan(i * olen, olen), expected)) << "mlen = " << msgs[i].size() << ", olen = " << olen;
+    }
+  }
+}
+
+// Ensure that each of four SHAKE128 instances, permuted together, produces same output as a standalone SHAKE128 instance, absorbing same message, both when
+// messages are of equal length, absorbed in lockstep, and when they are not.
+TEST(Sha3XOF, SHAKE128x4MatchesScalar)
+{
+  constexpr size_t NBLOCKS = 3;
+  constexpr size_t OLEN = NBLOCKS * shake128::shake128_x4_t::BLOCK_BYTE_LEN;
+
+  for (size_t mlen = MIN_MSG_LEN; mlen < MAX_MSG_LEN; mlen++) {
+    for (const bool same_len : { true, false }) {
+      std::array<std::vector<uint8_t>, 4> msgs{};
+      for (size_t j = 0; j < msgs.size(); j++) {
+        msgs[j].resize(same_len ? mlen : (mlen + (j * 7)));
+        sha3_test_utils::random_data<uint8_t>(msgs[j]);
+      }
+
+      std::array<std::vector<uint8_t>, 4> computed{};
+      for (auto& out : computed) {
+        out.resize(OLEN);
+      }
+
+      // Absorb in two calls and squeeze in two calls, to exercise lanes with some bytes already absorbed.
+      const auto split = [&](const size_t j) { return std::min(msgs[j].size(), mlen / 3); };
+
+      shake128::shake128_x4_t hasher;
+      hasher.absorb(std::span(msgs[0]).first(split(0)),
+                    std::span(msgs[1]).first(split(1)),
+                    std::span(msgs[2]).first(split(2)),
+                    std::span(msgs[3]).first(split(3)));
+      hasher.absorb(std::span(msgs[0]).subspan(split(0)),
+                    std::span(msgs[1]).subspan(split(1)),
+                    std::span(msgs[2]).subspan(split(2)),
+                    std::span(msgs[3]).subspan(split(3)));
+      hasher.finalize();
+      hasher.squeezeblocks(computed[0], computed[1], computed[2], computed[3], 1);
+
+      const size_t off = shake128::shake128_x4_t::BLOCK_BYTE_LEN;
+      hasher.squeezeblocks(std::span(computed[0]).subspan(off),
+                           std::span(computed[1]).subspan(off),
+                           std::span(computed[2]).subspan(off),
+                           std::span(computed[3]).subspan(off),
+                           NBLOCKS - 1);
+
+      for (size_t j = 0; j < msgs.size(); j++) {
+        std::vector<uint8_t> expected(OLEN);
+
+        shake128::shake128_t scalar;
+        scalar.absorb(msgs[j]);
+        scalar.finalize();
+        scalar.squeeze(expected);
+
+        EXPECT_EQ(computed[j], expected) << "mlen = " << msgs[j].size() << ", instance = " << j;
+      }
+    }
+  }
+}
+
+// Ensure that reading SHAKE128 output, through a buffered reader, refilling a single block at a time, in pieces of all kinds and lengths, produces same bytes as
+// squeezing it directly.
+TEST(Sha3XOF, SHAKE128BufferedReader)
+{
+  for (size_t mlen = MIN_MSG_LEN; mlen < MAX_MSG_LEN; mlen += 7) {
+    std::vector<uint8_t> msg(mlen);
+    sha3_test_utils::random_data<uint8_t>(msg);
+
+    shake128::shake128_t hasher;
+    hasher.absorb(msg);
+    hasher.finalize();
+
+    auto clone = hasher;
+
+    for (const size_t olen : { MIN_OUT_LEN, MAX_OUT_LEN, MAX_OUT_LEN * 3 }) {
+      std::vector<uint8_t> expected(olen);
+      clone.squeeze(expected);
+
+      shake128::reader_t<> reader(hasher);
+      EXPECT_EQ(sha3_test_utils::read_in_pieces(reader, olen), expected) << "mlen = " << mlen << ", olen = " << olen;
+
+      hasher = clone;
+    }
+  }
+}
+
+// Ensure that rejection sampling of uniform integers, out of SHAKE128 output, agrees with the reference sampler, for moduli of ML-KEM and ML-DSA, along with
+// some more, for both packed 12 -bit candidates and 3 -byte ones.
+TEST(Sha3XOF, SHAKE128SampleUniform)
+{
+  constexpr std::array<size_t, 6> LENS{ 0, 1, 7, 9, 256, 1000 };
+
+  std::array<uint8_t, 34> seed{};
+
+  for (const size_t len : LENS) {
+    sha3_test_utils::random_data<uint8_t>(seed);
+
+    test_shake128_sample_uniform<3329, uint16_t>(seed, len);
+    test_shake128_sample_uniform<3329, uint32_t>(seed, len);
+    test_shake128_sample_uniform<17, uint16_t>(seed, len);
+    test_shake128_sample_uniform<4096, uint16_t>(seed, len);
+    test_shake128_sample_uniform<8380417, uint32_t>(seed, len);
+    test_shake128_sample_uniform<65521, uint16_t>(seed, len);
+    test_shake128_sample_uniform<(1U << 24) - 3, uint32_t>(seed, len);
+  }
+}
@@ -2,8 +2,10 @@
 #include "test_conf.hpp"
 #include "test_utils.hpp"
 #include <algorithm>
+#include <array>
 #include <fstream>
 #include <gtest/gtest.h>
+#include <span>
 #include <vector>
 
 namespace {
@@ -149,3 +151,118 @@ TEST(Sha3XOF, SHAKE256KnownAnswerTests)
 
   file.close();
 }
+
+// Ensure that each of four SHAKE256 instances, permuted together, produces same output as a standalone SHAKE256 instance, absorbing same message, both when
+// messages are of equal length, absorbed in lockstep, and when they are not.
+TEST(Sha3XOF, SHAKE256x4MatchesScalar)
+{
+  constexpr size_t NBLOCKS = 3;
+  constexpr size_t OLEN = NBLOCKS * shake256::shake256_x4_t::BLOCK_BYTE_LEN;
+
+  for (size_t mlen = MIN_MSG_LEN; mlen < MAX_MSG_LEN; mlen++) {
+    for (const bool same_len : { true, false }) {
+      std::array<std::vector<uint8_t>, 4> msgs{};
+      for (size_t j = 0; j < msgs.size(); j++) {
+        msgs[j].resize(same_len ? mlen : (mlen + (j * 7)));
+        sha3_test_utils::random_data<uint8_t>(msgs[j]);
+      }
+
+      std::array<std::vector<uint8_t>, 4> computed{};
+      for (auto& out : computed) {
+        out.resize(OLEN);
+      }
+
+      // Absorb in two calls and squeeze in two calls, to exercise lanes with some bytes already absorbed.
+      const auto split = [&](const size_t j) { return std::min(msgs[j].size(), mlen / 3); };
+
+      shake256::shake256_x4_t hasher;
+      hasher.absorb(std::span(msgs[0]).first(split(0)),
+                    std::span(msgs[1]).first(split(1)),
+                    std::span(msgs[2]).first(split(2)),
+                    std::span(msgs[3]).first(split(3)));
+      hasher.absorb(std::span(msgs[0]).subspan(split(0)),
+                    std::span(msgs[1]).subspan(split(1)),
+                    std::span(msgs[2]).subspan(split(2)),
+                    std::span(msgs[3]).subspan(split(3)));
+      hasher.finalize();
+      hasher.squeezeblocks(computed[0], computed[1], computed[2], computed[3], 1);
+
+      const size_t off = shake256::shake256_x4_t::BLOCK_BYTE_LEN;
+      hasher.squeezeblocks(std::span(computed[0]).subspan(off),
+                           std::span(computed[1]).subspan(off),
+                           std::span(computed[2]).subspan(off),
+                           std::span(computed[3]).subspan(off),
+                           NBLOCKS - 1);
+
+      for (size_t j = 0; j < msgs.size(); j++) {
+        std::vector<uint8_t> expected(OLEN);
+
+        shake256::shake256_t scalar;
+        scalar.absorb(msgs[j]);
+        scalar.finalize();
+        scalar.squeeze(expected);
+
+        EXPECT_EQ(computed[j], expected) << "mlen = " << msgs[j].size() << ", instance = " << j;
+      }
+    }
+  }
+}
+
+namespace {
+
+// Advances `chain_cnt` random hash chains, over `value_len` -byte values, by random # -of steps, using `advance` and by hashing each value on its own.
+template<size_t value_len, typename advance_t>
+void
+test_shake256_hash_chains(const size_t chain_cnt, advance_t&& advance)
+{
+  std::vector<std::array<uint8_t, value_len>> values(chain_cnt);
+  std::vector<size_t> steps(chain_cnt);
+
+  for (size_t i = 0; i < chain_cnt; i++) {
+    sha3_test_utils::random_data<uint8_t>(values[i]);
+    steps[i] = (i * 7) % 17; // Includes chains which need no step at all
+  }
+
+  auto expected = values;
+  for (size_t i = 0; i < chain_cnt; i++) {
+    for (size_t step = 0; step < steps[i]; step++) {
+      shake256::shake256_t hasher;
+      hasher.absorb(expected[i]);
+      hasher.finalize();
+      hasher.squeeze(expected[i]);
+    }
+  }
+
+  advance(std::span(values), std::span<const size_t>(steps));
+  EXPECT_EQ(values, expected) << "value_len = " << value_len << ", chain_cnt = " << chain_cnt;
+}
+
+template<size_t value_len>
+void
+test_shake256_hash_chains(const size_t chain_cnt)
+{
+  using namespace shake256;
+
+  test_shake256_hash_chains<value_len>(chain_cnt, [](auto values, auto steps) { advance_chains(values, steps); });
+  test_shake256_hash_chains<value_len>(chain_cnt, [](auto values, auto steps) {
+    sponge::advance_chains_using<DOM_SEP, DOM_SEP_BW, RATE, NUM_KECCAK_ROUNDS, value_len, keccak::X4_STATE_CNT>(values, steps);
+  });
+  test_shake256_hash_chains<value_len>(chain_cnt, [](auto values, auto steps) {
+    sponge::advance_chains_using<DOM_SEP, DOM_SEP_BW, RATE, NUM_KECCAK_ROUNDS, value_len, keccak::X8_STATE_CNT>(values, steps);
+  });
+}
+
+}
+
+// Ensure that advancing many hash chains, in lanes of multi-buffer permutation, produces same values as iterating SHAKE256 on each of them, one after another.
+TEST(Sha3XOF, SHAKE256HashChains)
+{
+  constexpr std::array<size_t, 6> CHAIN_CNTS{ 0, 1, 3, 8, 13, 67 };
+
+  for (const size_t chain_cnt : CHAIN_CNTS) {
+    test_shake256_hash_chains<16>(chain_cnt);
+    test_shake256_hash_chains<20>(chain_cnt);
+    test_shake256_hash_chains<32>(chain_cnt);
+    test_shake256_hash_chains<64>(chain_cnt);
+  }
+}
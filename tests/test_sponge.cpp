@@ -0,0 +1,334 @@
+#include "sha3/internals/backend.hpp"
+#include "sha3/internals/job_manager.hpp"
+#include "sha3/internals/keccak.hpp"
+#include "sha3/internals/sponge.hpp"
+#include "sha3/internals/sponge_many.hpp"
+#include "test_conf.hpp"
+#include "test_utils.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <optional>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace {
+
+/**
+ * Absorbs message in chunks of `chunk_len` -bytes, finalizes the sponge and squeezes output in chunks of `chunk_len` -bytes, using absorb and squeeze loops
+ * of the sponge, compiled for `backend`.
+ */
+template<size_t num_bits_in_rate, size_t num_rounds>
+void
+absorb_then_squeeze(const keccak::backend_t backend, std::span<const uint8_t> msg, std::span<uint8_t> out, const size_t chunk_len)
+{
+  const auto absorb = sponge::absorb_fn<num_bits_in_rate, num_rounds>(backend);
+  const auto squeeze = sponge::squeeze_fn<num_bits_in_rate, num_rounds>(backend);
+
+  std::array<uint64_t, keccak::LANE_CNT> state{};
+  size_t offset = 0;
+
+  for (size_t off = 0; off < msg.size(); off += chunk_len) {
+    absorb(state, offset, msg.subspan(off, std::min(chunk_len, msg.size() - off)));
+  }
+
+  sponge::finalize<0x1f, 5, num_bits_in_rate, num_rounds>(state, offset);
+
+  size_t squeezable = num_bits_in_rate / 8;
+  for (size_t off = 0; off < out.size(); off += chunk_len) {
+    squeeze(state, squeezable, out.subspan(off, std::min(chunk_len, out.size() - off)));
+  }
+}
+
+// Ensure that absorb and squeeze loops of the sponge, compiled for each backend supported by this CPU, produce same output as the scalar ones.
+template<size_t num_bits_in_rate, size_t num_rounds>
+void
+test_sponge_backends()
+{
+  constexpr std::array<size_t, 6> CHUNK_LENS{ 1, 7, 8, 64, num_bits_in_rate / 8, 1000 };
+
+  for (size_t mlen = MIN_MSG_LEN; mlen < MAX_MSG_LEN; mlen += 13) {
+    std::vector<uint8_t> msg(mlen);
+    sha3_test_utils::random_data<uint8_t>(msg);
+
+    for (const auto chunk_len : CHUNK_LENS) {
+      std::vector<uint8_t> expected(MAX_OUT_LEN);
+      absorb_then_squeeze<num_bits_in_rate, num_rounds>(keccak::backend_t::scalar, msg, expected, chunk_len);
+
+      for (const auto backend : keccak::BACKENDS) {
+        if (!keccak::is_backend_supported(backend)) {
+          continue;
+        }
+
+        std::vector<uint8_t> computed(MAX_OUT_LEN);
+        absorb_then_squeeze<num_bits_in_rate, num_rounds>(backend, msg, computed, chunk_len);
+
+        EXPECT_EQ(computed, expected) << "backend = " << keccak::backend_name(backend) << ", mlen = " << mlen << ", chunk_len = " << chunk_len;
+      }
+    }
+  }
+}
+
+
+// Ensure that absorbing a message in a single call, which consumes full blocks using the fused loop, results in same state as absorbing it one byte at a
+// time, which never takes the fused loop. Message is absorbed after `prefix_len` -bytes, so that the fused loop also starts from a block boundary which is
+// reached in the middle of an absorb call.
+template<size_t num_bits_in_rate>
+void
+test_sponge_fused_absorb()
+{
+  constexpr size_t num_bytes_in_rate = num_bits_in_rate / 8;
+  constexpr std::array<size_t, 3> PREFIX_LENS{ 0, 1, num_bytes_in_rate - 1 };
+
+  for (size_t mlen = MIN_MSG_LEN; mlen < (4 * num_bytes_in_rate); mlen += 5) {
+    std::vector<uint8_t> msg(mlen);
+    sha3_test_utils::random_data<uint8_t>(msg);
+
+    for (const auto prefix_len : PREFIX_LENS) {
+      std::vector<uint8_t> prefix(prefix_len);
+      sha3_test_utils::random_data<uint8_t>(prefix);
+
+      std::array<uint64_t, keccak::LANE_CNT> fused{};
+      size_t fused_offset = 0;
+      sponge::absorb_using<num_bits_in_rate, 24>(fused, fused_offset, prefix);
+      sponge::absorb_using<num_bits_in_rate, 24>(fused, fused_offset, msg);
+
+      std::array<uint64_t, keccak::LANE_CNT> bytewise{};
+      size_t bytewise_offset = 0;
+      sponge::absorb_using<num_bits_in_rate, 24>(bytewise, bytewise_offset, prefix);
+      for (size_t i = 0; i < msg.size(); i++) {
+        sponge::absorb_using<num_bits_in_rate, 24>(bytewise, bytewise_offset, std::span(msg).subspan(i, 1));
+      }
+
+      EXPECT_EQ(fused, bytewise) << "mlen = " << mlen << ", prefix_len = " << prefix_len;
+      EXPECT_EQ(fused_offset, bytewise_offset) << "mlen = " << mlen << ", prefix_len = " << prefix_len;
+    }
+  }
+}
+
+
+// Ensure that absorbing a message, which starts at an unaligned address, from any byte offset of the rate portion and split in two calls at any point, XORs
+// each message byte into its little-endian position of the state, no matter whether words are loaded straight from the message or staged.
+template<size_t num_bits_in_rate>
+void
+test_sponge_unaligned_absorb()
+{
+  constexpr size_t num_bytes_in_rate = num_bits_in_rate / 8;
+
+  std::vector<uint8_t> buffer(num_bytes_in_rate);
+  sha3_test_utils::random_data<uint8_t>(buffer);
+
+  for (size_t split_at = 0; split_at < 8; split_at++) {
+    for (size_t offset = 0; offset < 16; offset++) {
+      // Message never fills the rate portion, so that the state is not permuted.
+      const auto msg = std::span<const uint8_t>(buffer).subspan(1 + (split_at % 2), num_bytes_in_rate - offset - 2);
+
+      std::array<uint64_t, keccak::LANE_CNT> expected{};
+      for (size_t i = 0; i < msg.size(); i++) {
+        expected[(offset + i) / 8] ^= static_cast<uint64_t>(msg[i]) << (((offset + i) % 8) * 8);
+      }
+
+      std::array<uint64_t, keccak::LANE_CNT> computed{};
+      size_t computed_offset = offset;
+      sponge::absorb_using<num_bits_in_rate, 24>(computed, computed_offset, msg.subspan(0, split_at));
+      sponge::absorb_using<num_bits_in_rate, 24>(computed, computed_offset, msg.subspan(split_at));
+
+      EXPECT_EQ(computed, expected) << "split_at = " << split_at << ", offset = " << offset;
+      EXPECT_EQ(computed_offset, offset + msg.size()) << "split_at = " << split_at << ", offset = " << offset;
+    }
+  }
+}
+
+// Ensure that squeezing output in a single call, which produces full blocks using the fused loop, results in same output as squeezing it one byte at a
+// time, which never takes the fused loop. Output is squeezed after `prefix_len` -bytes, so that the fused loop also starts from a block boundary which is
+// reached in the middle of a squeeze call.
+template<size_t num_bits_in_rate>
+void
+test_sponge_fused_squeeze()
+{
+  constexpr size_t num_bytes_in_rate = num_bits_in_rate / 8;
+  constexpr std::array<size_t, 3> PREFIX_LENS{ 0, 1, num_bytes_in_rate - 1 };
+
+  std::array<uint64_t, keccak::LANE_CNT> initial_state{};
+  sha3_test_utils::random_data<uint64_t>(initial_state);
+
+  for (size_t olen = MIN_OUT_LEN; olen < (4 * num_bytes_in_rate); olen += 5) {
+    for (const auto prefix_len : PREFIX_LENS) {
+      std::vector<uint8_t> fused_prefix(prefix_len);
+      std::vector<uint8_t> fused(olen);
+      auto fused_state = initial_state;
+      size_t fused_squeezable = num_bytes_in_rate;
+      sponge::squeeze_using<num_bits_in_rate, 24>(fused_state, fused_squeezable, fused_prefix);
+      sponge::squeeze_using<num_bits_in_rate, 24>(fused_state, fused_squeezable, fused);
+
+      std::vector<uint8_t> bytewise_prefix(prefix_len);
+      std::vector<uint8_t> bytewise(olen);
+      auto bytewise_state = initial_state;
+      size_t bytewise_squeezable = num_bytes_in_rate;
+      sponge::squeeze_using<num_bits_in_rate, 24>(bytewise_state, bytewise_squeezable, bytewise_prefix);
+      for (size_t i = 0; i < bytewise.size(); i++) {
+        sponge::squeeze_using<num_bits_in_rate, 24>(bytewise_state, bytewise_squeezable, std::span(bytewise).subspan(i, 1));
+      }
+
+      EXPECT_EQ(fused, bytewise) << "olen = " << olen << ", prefix_len = " << prefix_len;
+      EXPECT_EQ(fused_state, bytewise_state) << "olen = " << olen << ", prefix_len = " << prefix_len;
+      EXPECT_EQ(fused_squeezable, bytewise_squeezable) << "olen = " << olen << ", prefix_len = " << prefix_len;
+    }
+  }
+}
+
+/**
+ * Submits jobs of unequal message and output lengths, ranging from empty to many blocks, to a multi-buffer job manager, with `lane_cnt` lanes, and checks
+ * that output of each job is same as hashing its message on its own. Completed jobs are either collected through a callback or in order of submission.
+ */
+template<size_t lane_cnt, bool use_callback>
+void
+test_sponge_job_manager()
+{
+  constexpr uint8_t DOM_SEP = 0b00001111;
+  constexpr size_t DOM_SEP_BW = 4;
+  constexpr size_t RATE = 1088;
+  constexpr size_t NUM_ROUNDS = 24;
+  constexpr size_t JOB_CNT = 97;
+
+  std::mt19937_64 gen(lane_cnt);
+  std::uniform_int_distribution<size_t> short_len(0, 300);
+  std::uniform_int_distribution<size_t> long_len(0, 5000);
+
+  std::vector<std::vector<uint8_t>> msgs(JOB_CNT);
+  std::vector<std::vector<uint8_t>> outs(JOB_CNT);
+
+  for (size_t i = 0; i < JOB_CNT; i++) {
+    msgs[i].resize((i % 7 == 0) ? long_len(gen) : short_len(gen));
+    outs[i].resize((i % 5 == 0) ? long_len(gen) : 32);
+
+    sha3_test_utils::random_data<uint8_t>(msgs[i]);
+  }
+
+  using job_manager_t = sponge::job_manager_t<DOM_SEP, DOM_SEP_BW, RATE, NUM_ROUNDS, lane_cnt>;
+
+  std::vector<sponge::job_id_t> completed;
+  job_manager_t manager = use_callback ? job_manager_t([&](const sponge::job_id_t id) { completed.push_back(id); }) : job_manager_t();
+
+  for (size_t i = 0; i < JOB_CNT; i++) {
+    EXPECT_EQ(manager.submit(msgs[i], outs[i]), i);
+    EXPECT_LT(manager.busy_lanes(), lane_cnt);
+
+    if constexpr (!use_callback) {
+      while (const auto id = manager.get_completed_job()) {
+        completed.push_back(*id);
+      }
+    }
+  }
+
+  manager.flush();
+  EXPECT_EQ(manager.busy_lanes(), 0U);
+
+  if constexpr (!use_callback) {
+    while (const auto id = manager.get_completed_job()) {
+      completed.push_back(*id);
+    }
+
+    EXPECT_TRUE(std::ranges::is_sorted(completed));
+  }
+
+  EXPECT_EQ(completed.size(), JOB_CNT);
+  std::ranges::sort(completed);
+  EXPECT_EQ(std::ranges::adjacent_find(completed), completed.end());
+
+  for (size_t i = 0; i < JOB_CNT; i++) {
+    std::vector<uint8_t> expected(outs[i].size());
+    sponge::hash_one<DOM_SEP, DOM_SEP_BW, RATE, NUM_ROUNDS>(msgs[i], expected);
+
+    EXPECT_EQ(outs[i], expected) << "job = " << i << ", mlen = " << msgs[i].size() << ", olen = " << outs[i].size();
+  }
+}
+
+}
+
+// Ensure that the backend, bound at runtime, can be run on this CPU and that it is the one used by Keccak-p[1600] permutation.
+TEST(SpongeBackend, ActiveBackendIsSupported)
+{
+  const auto backend = keccak::active_backend();
+
+  EXPECT_TRUE(keccak::is_backend_supported(backend));
+  EXPECT_NE(keccak::backend_name(backend), "unknown");
+  EXPECT_EQ(keccak::active_backend(), backend);
+}
+
+// Ensure that Keccak-p[1600] permutation, implemented by each backend supported by this CPU, agrees with the portable one.
+TEST(SpongeBackend, EveryBackendPermutationMatchesPortable)
+{
+  for (const auto backend : keccak::BACKENDS) {
+    if (!keccak::is_backend_supported(backend)) {
+      continue;
+    }
+
+    std::array<uint64_t, keccak::LANE_CNT> state12{};
+    std::array<uint64_t, keccak::LANE_CNT> state24{};
+    sha3_test_utils::random_data<uint64_t>(state12);
+    sha3_test_utils::random_data<uint64_t>(state24);
+
+    auto expected12 = state12;
+    auto expected24 = state24;
+
+    keccak::permute_fn<12>(backend)(state12);
+    keccak::permute_portable<12>(expected12);
+    keccak::permute_fn<24>(backend)(state24);
+    keccak::permute_portable<24>(expected24);
+
+    EXPECT_EQ(state12, expected12) << "backend = " << keccak::backend_name(backend);
+    EXPECT_EQ(state24, expected24) << "backend = " << keccak::backend_name(backend);
+  }
+}
+
+TEST(SpongeBackend, EveryBackendAbsorbSqueezeMatchesScalarRate1088Rounds24)
+{
+  test_sponge_backends<1088, 24>();
+}
+
+TEST(SpongeBackend, EveryBackendAbsorbSqueezeMatchesScalarRate1344Rounds12)
+{
+  test_sponge_backends<1344, 12>();
+}
+
+TEST(SpongeFusedAbsorb, MatchesBytewiseAbsorbForEveryRate)
+{
+  test_sponge_fused_absorb<576>();
+  test_sponge_fused_absorb<832>();
+  test_sponge_fused_absorb<1088>();
+  test_sponge_fused_absorb<1152>();
+  test_sponge_fused_absorb<1344>();
+}
+
+TEST(SpongeUnalignedAbsorb, MatchesBytewiseXorForEveryRate)
+{
+  test_sponge_unaligned_absorb<576>();
+  test_sponge_unaligned_absorb<832>();
+  test_sponge_unaligned_absorb<1088>();
+  test_sponge_unaligned_absorb<1152>();
+  test_sponge_unaligned_absorb<1344>();
+}
+
+TEST(SpongeFusedSqueeze, MatchesBytewiseSqueezeForEveryRate)
+{
+  test_sponge_fused_squeeze<576>();
+  test_sponge_fused_squeeze<832>();
+  test_sponge_fused_squeeze<1088>();
+  test_sponge_fused_squeeze<1152>();
+  test_sponge_fused_squeeze<1344>();
+}
+
+TEST(SpongeJobManager, MatchesOneShotHashingX4)
+{
+  test_sponge_job_manager<keccak::X4_STATE_CNT, false>();
+  test_sponge_job_manager<keccak::X4_STATE_CNT, true>();
+}
+
+TEST(SpongeJobManager, MatchesOneShotHashingX8)
+{
+  test_sponge_job_manager<keccak::X8_STATE_CNT, false>();
+  test_sponge_job_manager<keccak::X8_STATE_CNT, true>();
+}
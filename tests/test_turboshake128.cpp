@@ -175,3 +175,90 @@ TEST(Sha3XOF, TurboSHAKE128KnownAnswerTests)
   }
   // clang-format on
 }
+
+// Ensure that batched one-shot hashing of records, laid out at a fixed stride, using a non-default domain separator, produces same output as absorbing,
+// finalizing and squeezing each of them separately.
+TEST(Sha3XOF, TurboSHAKE128HashManyStrided)
+{
+  constexpr size_t RECORD_CNT = 13;
+  constexpr size_t OLEN = 200;
+  constexpr uint8_t DOM_SEP = 0x06;
+
+  constexpr std::array<size_t, 4> RECORD_LENS{ 0, 64, 168, 500 };
+
+  for (const size_t record_len : RECORD_LENS) {
+    const size_t stride = record_len + 3;
+
+    std::vector<uint8_t> records(((RECORD_CNT - 1) * stride) + record_len);
+    sha3_test_utils::random_data<uint8_t>(records);
+
+    std::vector<uint8_t> computed(RECORD_CNT * OLEN);
+    turboshake128::turboshake128_t::hash_many<DOM_SEP>(records, record_len, stride, computed, OLEN);
+
+    for (size_t i = 0; i < RECORD_CNT; i++) {
+      std::vector<uint8_t> expected(OLEN);
+
+      turboshake128::turboshake128_t hasher;
+      hasher.absorb(std::span(records).subspan(i * stride, record_len));
+      hasher.finalize<DOM_SEP>();
+      hasher.squeeze(expected);
+
+      EXPECT_TRUE(std::ranges::equal(std::span(computed).subspan(i * OLEN, OLEN), expected)) << "record_len = " << record_len << ", i = " << i;
+    }
+  }
+}
+
+// Ensure that reading TurboSHAKE128 output, through a buffered reader, refilling two blocks at a time, in pieces of all kinds and lengths, produces same bytes as
+// squeezing it directly.
+TEST(Sha3XOF, TurboSHAKE128BufferedReader)
+{
+  for (size_t mlen = MIN_MSG_LEN; mlen < MAX_MSG_LEN; mlen += 7) {
+    std::vector<uint8_t> msg(mlen);
+    sha3_test_utils::random_data<uint8_t>(msg);
+
+    turboshake128::turboshake128_t hasher;
+    hasher.absorb(msg);
+    hasher.finalize<0x0b>();
+
+    auto clone = hasher;
+
+    for (const size_t olen : { MIN_OUT_LEN, MAX_OUT_LEN, MAX_OUT_LEN * 3 }) {
+      std::vector<uint8_t> expected(olen);
+      clone.squeeze(expected);
+
+      turboshake128::reader_t<2> reader(hasher);
+      EXPECT_EQ(sha3_test_utils::read_in_pieces(reader, olen), expected) << "mlen = " << mlen << ", olen = " << olen;
+
+      hasher = clone;
+    }
+  }
+}
+
+// Ensure that advancing many hash chains, using a non-default domain separator, produces same values as iterating TurboSHAKE128 on each of them.
+TEST(Sha3XOF, TurboSHAKE128HashChains)
+{
+  constexpr size_t CHAIN_CNT = 35;
+  constexpr size_t VALUE_LEN = 24;
+  constexpr uint8_t DOM_SEP = 0x0b;
+
+  std::vector<std::array<uint8_t, VALUE_LEN>> values(CHAIN_CNT);
+  std::vector<size_t> steps(CHAIN_CNT);
+
+  for (size_t i = 0; i < CHAIN_CNT; i++) {
+    sha3_test_utils::random_data<uint8_t>(values[i]);
+    steps[i] = (i * 5) % 16;
+  }
+
+  auto expected = values;
+  for (size_t i = 0; i < CHAIN_CNT; i++) {
+    for (size_t step = 0; step < steps[i]; step++) {
+      turboshake128::turboshake128_t hasher;
+      hasher.absorb(expected[i]);
+      hasher.finalize<DOM_SEP>();
+      hasher.squeeze(expected[i]);
+    }
+  }
+
+  turboshake128::advance_chains<DOM_SEP>(std::span(values), std::span<const size_t>(steps));
+  EXPECT_EQ(values, expected);
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <charconv>
 #include <cstdint>
@@ -119,4 +120,51 @@ ptn(const size_t n)
   return res;
 }
 
+/**
+ * Reads `len` -bytes of XOF output, through buffered XOF reader `reader`, cycling through single bytes, `uint16_t` and `uint32_t` values, and short and long
+ * spans of bytes, s.t. reads of all kinds cross buffer boundaries. Integers are serialized back as little-endian bytes, so the result can be compared against
+ * squeezing the XOF directly.
+ */
+template<typename reader_t>
+static inline std::vector<uint8_t>
+read_in_pieces(reader_t& reader, const size_t len)
+{
+  constexpr std::array<size_t, 6> PIECE_LENS{ 1, 2, 4, 3, 1, reader_t::BUFFER_BYTE_LEN + 5 };
+
+  std::vector<uint8_t> res;
+  res.reserve(len + PIECE_LENS.back());
+
+  for (size_t i = 0; res.size() < len; i++) {
+    const size_t piece_len = PIECE_LENS[i % PIECE_LENS.size()];
+
+    switch (i % PIECE_LENS.size()) {
+      case 0:
+        res.push_back(reader.read_u8());
+        break;
+      case 1: {
+        const uint16_t value = reader.read_u16();
+        res.push_back(static_cast<uint8_t>(value));
+        res.push_back(static_cast<uint8_t>(value >> 8U));
+        break;
+      }
+      case 2: {
+        const uint32_t value = reader.read_u32();
+        for (size_t k = 0; k < sizeof(value); k++) {
+          res.push_back(static_cast<uint8_t>(value >> (k * 8U)));
+        }
+        break;
+      }
+      default: {
+        const size_t off = res.size();
+        res.resize(off + piece_len);
+        reader.read(std::span(res).subspan(off));
+        break;
+      }
+    }
+  }
+
+  res.resize(len);
+  return res;
+}
+
 }